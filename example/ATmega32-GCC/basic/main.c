@@ -29,6 +29,7 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <avr/io.h>
 #include <util/delay.h>
 #include "Retarget.h"
@@ -42,7 +43,7 @@ int main(void)
   SHT3x_Sample_t  Sample = {0};
 
   Retarget_Init(F_CPU, 9600);
-  printf("SHT3x Driver Example\r\n\r\n")
+  printf("SHT3x Driver Example\r\n\r\n");
 
   SHT3x_Platform_Init(&Handler);
   SHT3x_Init(&Handler, 0);
@@ -51,10 +52,13 @@ int main(void)
   while (1)
   {
     SHT3x_ReadSample(&Handler, &Sample);
-    printf("Temperature: %f°C\r\n"
-           "Humidity: %f%%\r\n\r\n",
-           Sample.TempCelsius,
-           Sample.HumidityPercent);
+    printf("Temperature: %s%d.%02d°C\r\n"
+           "Humidity: %u.%02u%%\r\n\r\n",
+           (Sample.TempCentiCelsius < 0) ? "-" : "",
+           abs(Sample.TempCentiCelsius) / 100,
+           abs(Sample.TempCentiCelsius) % 100,
+           Sample.HumCentiPercent / 100,
+           Sample.HumCentiPercent % 100);
 
     _delay_ms(1000);
   }
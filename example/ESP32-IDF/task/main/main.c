@@ -0,0 +1,82 @@
+/**
+ **********************************************************************************
+ * @file   main.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  sensor task example for SHT3x Driver (for ESP32-IDF)
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+#include "SHT3x.h"
+#include "SHT3x_platform.h"
+#include "SHT3x_task.h"
+
+static const char *TAG = "example";
+
+static SHT3x_Handler_t Handlers[2] = {0};
+static SHT3x_Task_t SensorTask = {0};
+
+void app_main(void)
+{
+  SHT3x_TaskMessage_t Message = {0};
+  uint8_t i;
+
+  ESP_LOGI(TAG, "SHT3x Sensor Task Example");
+
+  // Two sensors on the default bus (ADDR pin low and high)
+  for (i = 0; i < 2; i++)
+  {
+    SHT3x_Platform_Init(&Handlers[i]);
+    SHT3x_Init(&Handlers[i], i);
+    SHT3x_SetModeSingleShot(&Handlers[i], SHT3x_REPEATABILITY_HIGH);
+  }
+
+  SHT3x_TaskInit(&SensorTask, Handlers, 2, 1000, 8, NULL);
+  SHT3x_TaskStart(&SensorTask, "sht3x", 4096, 5);
+
+  while (1)
+  {
+    if (xQueueReceive(SensorTask.Queue, &Message, portMAX_DELAY) != pdTRUE)
+      continue;
+
+    if (Message.Result != SHT3x_OK)
+    {
+      ESP_LOGW(TAG, "Sensor %u: read failed", Message.Index);
+      continue;
+    }
+
+    ESP_LOGI(TAG, "Sensor %u: Temperature: %f°C, "
+                  "Humidity: %f%%",
+             Message.Index,
+             Message.Sample.TempCelsius,
+             Message.Sample.HumidityPercent);
+  }
+}
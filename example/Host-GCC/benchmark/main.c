@@ -0,0 +1,199 @@
+/**
+ **********************************************************************************
+ * @file   main.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  benchmark of SHT3x Driver on a simulated sensor (host)
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "SHT3x.h"
+#include "SHT3x_platform.h"
+
+#define SAMPLE_COUNT  1000
+
+typedef enum Bench_Mode_e
+{
+  BENCH_SINGLESHOT,
+  BENCH_SINGLESHOT_STRETCHING,
+  BENCH_PERIODIC,
+  BENCH_ART,
+} Bench_Mode_t;
+
+typedef struct Bench_Case_s
+{
+  const char *Name;
+  Bench_Mode_t Mode;
+  SHT3x_Repeatability_t Repeatability;
+  uint8_t UseGetTime;
+  uint8_t UseSendReceive;
+  uint8_t UseFetchWait;
+} Bench_Case_t;
+
+static const Bench_Case_t Cases[] =
+{
+  {"single shot low",            BENCH_SINGLESHOT, SHT3x_REPEATABILITY_LOW, 0, 1, 0},
+  {"single shot medium",         BENCH_SINGLESHOT, SHT3x_REPEATABILITY_MEDIUM, 0, 1, 0},
+  {"single shot high",           BENCH_SINGLESHOT, SHT3x_REPEATABILITY_HIGH, 0, 1, 0},
+  {"single shot high, timed",    BENCH_SINGLESHOT, SHT3x_REPEATABILITY_HIGH, 1, 1, 0},
+  {"single shot high, stretch",  BENCH_SINGLESHOT_STRETCHING, SHT3x_REPEATABILITY_HIGH, 0, 1, 0},
+  {"periodic 10mps, write+read", BENCH_PERIODIC, SHT3x_REPEATABILITY_HIGH, 1, 0, 0},
+  {"periodic 10mps, combined",   BENCH_PERIODIC, SHT3x_REPEATABILITY_HIGH, 1, 1, 0},
+  {"periodic 10mps, fetch wait", BENCH_PERIODIC, SHT3x_REPEATABILITY_HIGH, 1, 1, 1},
+  {"ART, combined",              BENCH_ART, SHT3x_REPEATABILITY_HIGH, 1, 1, 0},
+  {"ART, fetch wait",            BENCH_ART, SHT3x_REPEATABILITY_HIGH, 1, 1, 1},
+};
+
+
+static uint64_t
+Bench_Nanoseconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static uint64_t
+Bench_Cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __builtin_ia32_rdtsc();
+#else
+  return 0;
+#endif
+}
+
+static int
+Bench_Run(const Bench_Case_t *Case)
+{
+  SHT3x_PlatformSim_t Sim;
+  SHT3x_Handler_t Handler = {0};
+  SHT3x_Sample_t Sample = {0};
+  SHT3x_Result_t Result;
+  uint64_t StartNs, StartCycles, HostNs = 0, HostCycles = 0;
+  uint64_t StartTime, BusTime;
+  uint32_t Calls = 0, Failed = 0, Samples = 0;
+  uint32_t Transactions, Bytes, Nacks;
+
+  SHT3x_PlatformSim_Init(&Sim);
+  Handler.Context = &Sim;
+  SHT3x_Platform_Init(&Handler);
+  if (!Case->UseGetTime)
+    Handler.PlatformGetTime = NULL;
+  if (!Case->UseSendReceive)
+    Handler.PlatformSendReceive = NULL;
+
+  if (SHT3x_Init(&Handler, 0) != SHT3x_OK)
+  {
+    printf("%-28s init failed\n", Case->Name);
+    return 1;
+  }
+
+  switch (Case->Mode)
+  {
+  case BENCH_SINGLESHOT_STRETCHING:
+    SHT3x_SetClockStretching(&Handler, 1);
+    // fall through
+  case BENCH_SINGLESHOT:
+    SHT3x_SetModeSingleShot(&Handler, Case->Repeatability);
+    break;
+  case BENCH_PERIODIC:
+    SHT3x_SetModePeriodic(&Handler, SHT3x_SPEED_10MPS, Case->Repeatability);
+    break;
+  case BENCH_ART:
+    SHT3x_SetModeART(&Handler);
+    break;
+  }
+
+  SHT3x_SetFetchWait(&Handler, Case->UseFetchWait);
+
+  Sim.Transactions = Sim.BytesSent = Sim.BytesReceived = Sim.Nacks = 0;
+  StartTime = Sim.Time;
+
+  while (Samples < SAMPLE_COUNT)
+  {
+    StartNs = Bench_Nanoseconds();
+    StartCycles = Bench_Cycles();
+    Result = SHT3x_ReadSample(&Handler, &Sample);
+    HostCycles += Bench_Cycles() - StartCycles;
+    HostNs += Bench_Nanoseconds() - StartNs;
+    Calls++;
+
+    if (Result == SHT3x_OK)
+      Samples++;
+    else if (Result != SHT3x_NO_DATA)
+      Failed++;
+
+    // In periodic modes the application polls at a fixed rate
+    if ((Case->Mode == BENCH_PERIODIC || Case->Mode == BENCH_ART) &&
+        !Case->UseFetchWait)
+      Sim.Time += 10000;
+
+    if (Failed > SAMPLE_COUNT)
+      break;
+  }
+
+  BusTime = Sim.Time - StartTime;
+  Transactions = Sim.Transactions;
+  Bytes = Sim.BytesSent + Sim.BytesReceived;
+  Nacks = Sim.Nacks;
+
+  printf("%-28s %8.0f %10.0f %8.2f %8.2f %7.2f %10.1f %6u\n",
+         Case->Name,
+         (double)HostNs / Calls,
+         (double)HostCycles / Calls,
+         (double)Transactions / SAMPLE_COUNT,
+         (double)Bytes / SAMPLE_COUNT,
+         (double)Nacks / SAMPLE_COUNT,
+         (double)BusTime / SAMPLE_COUNT,
+         Failed);
+
+  SHT3x_DeInit(&Handler);
+
+  return Failed ? 1 : 0;
+}
+
+int main(void)
+{
+  int Failed = 0;
+  size_t i;
+
+  printf("SHT3x driver benchmark (%u samples per case, %u Hz bus)\n"
+         "Host time is per SHT3x_ReadSample() call, bus figures and\n"
+         "simulated time are per sample.\n\n",
+         SAMPLE_COUNT, SHT3X_SIM_I2C_RATE);
+  printf("%-28s %8s %10s %8s %8s %7s %10s %6s\n",
+         "case", "ns", "cycles", "xfers", "bytes", "nacks",
+         "bus us", "failed");
+
+  for (i = 0; i < sizeof(Cases) / sizeof(Cases[0]); i++)
+    Failed |= Bench_Run(&Cases[i]);
+
+  return Failed;
+}
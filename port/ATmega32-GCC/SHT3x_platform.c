@@ -30,8 +30,14 @@
 
 /* Includes ---------------------------------------------------------------------*/
 #include "SHT3x_platform.h"
+#if (SHT3X_CONFIG_STATIC_PLATFORM == 1)
+#include "SHT3x_static.h"
+#endif
 #include <avr/io.h>
 #include <util/delay.h>
+#if (SHT3X_ASYNC == 1)
+#include <avr/interrupt.h>
+#endif
 
 
 /* Private Macro ----------------------------------------------------------------*/
@@ -51,6 +57,55 @@
 #define CHECKBIT(reg,bit) ((reg & _BV(bit)) ? 1 : 0)
 #endif
 
+/**
+ * @brief  Platform functions are called directly by the driver if
+ *         SHT3X_CONFIG_STATIC_PLATFORM is 1 (see SHT3x_static.h)
+ */
+#if (SHT3X_CONFIG_STATIC_PLATFORM == 1)
+#define SHT3X_PLATFORM_FUNCTION
+#else
+#define SHT3X_PLATFORM_FUNCTION  static
+#endif
+
+
+
+/* Private Constants ------------------------------------------------------------*/
+/**
+ * @brief  TWI status codes (master mode)
+ */
+#define TW_START          0x08
+#define TW_REP_START      0x10
+#define TW_MT_SLA_ACK     0x18
+#define TW_MT_SLA_NACK    0x20
+#define TW_MT_DATA_ACK    0x28
+#define TW_MT_DATA_NACK   0x30
+#define TW_MR_SLA_ACK     0x40
+#define TW_MR_SLA_NACK    0x48
+#define TW_MR_DATA_ACK    0x50
+#define TW_MR_DATA_NACK   0x58
+#define TW_STATUS         (TWSR & 0xF8)
+
+
+
+#if (SHT3X_ASYNC == 1)
+/* Private Data Types -----------------------------------------------------------*/
+typedef struct Platform_AsyncTransfer_s
+{
+  uint8_t Address;
+  uint8_t *Data;
+  uint8_t DataLen;
+  uint8_t Counter;
+  uint8_t Read;
+  SHT3x_TransferDone_t Done;
+  void *Arg;
+} Platform_AsyncTransfer_t;
+
+
+
+/* Private Variables ------------------------------------------------------------*/
+static volatile Platform_AsyncTransfer_t AsyncTransfer;
+#endif
+
 
 
 /**
@@ -59,38 +114,86 @@
  ==================================================================================
  */
 
+/**
+ * @brief  Wait for the current bus event (about SHT3X_TWI_TIMEOUT us at most)
+ * @retval 0 if the event is finished, -1 on timeout (the TWI is disabled)
+ */
+static int8_t
+Platform_Wait(void)
+{
+  for (uint16_t Counter = SHT3X_TWI_TIMEOUT; Counter; Counter--)
+  {
+    if (CHECKBIT(TWCR, TWINT))
+      return 0;
+    _delay_us(1);
+  }
+
+  TWCR = 0; // release the bus, next START enables the TWI again
+  return -1;
+}
+
+
+/**
+ * @brief  Send START (or repeated START) and the address byte
+ * @retval 0 if the address is acknowledged, -3 otherwise (STOP is sent)
+ */
 static int8_t
-Platform_Init(void)
+Platform_Start(uint8_t AddressByte, uint8_t AckStatus)
+{
+  TWCR = _BV(TWEN) | _BV(TWSTA) | _BV(TWEA) | _BV(TWINT); // TWI enable *** acknowledge enable
+  if (Platform_Wait() != 0) // wait until the process ends
+    return -1;
+
+  TWDR = AddressByte;                  // set data in data register to sending
+  TWCR = _BV(TWEN) | _BV(TWEA) | _BV(TWINT); // TWI enable *** acknowledge enable
+  if (Platform_Wait() != 0) // wait until the process ends
+    return -1;
+
+  if (TW_STATUS != AckStatus)
+  {
+    TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWSTO); // send the STOP mode bit
+    return -3;
+  }
+
+  return 0;
+}
+
+
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_Init(void *Context)
 {
+  (void)Context;
   TWBR = (uint8_t)(F_CPU - 1600000) / (2 * SHT3X_I2C_RATE);
   return 0;
 }
 
 
-static int8_t
-Platform_DeInit(void)
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_DeInit(void *Context)
 {
+  (void)Context;
   return 0;
 }
 
 
-static int8_t
-Platform_WriteData(uint8_t Address, uint8_t *Data, uint8_t DataLen)
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_WriteData(void *Context, uint8_t Address, uint8_t *Data, uint8_t DataLen)
 {
   uint8_t DataCounter = 0;
+  int8_t Result;
 
-  TWCR = _BV(TWEN) | _BV(TWSTA) | _BV(TWEA) | _BV(TWINT); // TWI enable *** acknowledge enable
-  while (!CHECKBIT(TWCR, TWINT)); // wait until the process ends
+  (void)Context;
 
-  TWDR = Address<<1;                  // set data in data register to sending
-  TWCR = _BV(TWEN) | _BV(TWEA) | _BV(TWINT); // TWI enable *** acknowledge enable
-  while (!CHECKBIT(TWCR, TWINT));
+  Result = Platform_Start(Address<<1, TW_MT_SLA_ACK);
+  if (Result != 0)
+    return Result;
 
   for (DataCounter = 0; DataCounter < DataLen; DataCounter++)
   {
     TWDR = Data[DataCounter];                  // set data in data register to sending
     TWCR = _BV(TWEN) | _BV(TWEA) | _BV(TWINT); // TWI enable *** acknowledge enable
-    while (!CHECKBIT(TWCR, TWINT));
+    if (Platform_Wait() != 0)
+      return -1;
   }
 
   TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWSTO); // send the STOP mode bit
@@ -99,26 +202,28 @@ Platform_WriteData(uint8_t Address, uint8_t *Data, uint8_t DataLen)
 }
 
 
-static int8_t
-Platform_ReadData(uint8_t Address, uint8_t *Data, uint8_t DataLen)
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_ReadData(void *Context, uint8_t Address, uint8_t *Data, uint8_t DataLen)
 {
   uint8_t DataCounter = 0;
+  int8_t Result;
 
-  TWCR = _BV(TWEN) | _BV(TWSTA) | _BV(TWEA) | _BV(TWINT); // TWI enable *** acknowledge enable
-  while (!CHECKBIT(TWCR, TWINT)); // wait until the process ends
+  (void)Context;
 
-  TWDR = (Address<<1) | 0x01;                  // set data in data register to sending
-  TWCR = _BV(TWEN) | _BV(TWEA) | _BV(TWINT); // TWI enable *** acknowledge enable
-  while (!CHECKBIT(TWCR, TWINT)); // wait until the process ends
+  Result = Platform_Start((Address<<1) | 0x01, TW_MR_SLA_ACK);
+  if (Result != 0)
+    return Result;
 
   for (DataCounter = 0; DataCounter < DataLen - 1; DataCounter++)
   {
     TWCR = _BV(TWEN) | _BV(TWEA) | _BV(TWINT); // TWI enable *** acknowledge enable
-    while (!CHECKBIT(TWCR, TWINT)); // wait until the process ends
+    if (Platform_Wait() != 0) // wait until the process ends
+      return -1;
     Data[DataCounter] = TWDR;
   }
   TWCR = _BV(TWEN) | _BV(TWINT); // TWI enable
-  while (!CHECKBIT(TWCR, TWINT)); // wait until the process ends
+  if (Platform_Wait() != 0) // wait until the process ends
+    return -1;
   Data[DataCounter] = TWDR;
 
   TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWSTO); // send the STOP mode bit
@@ -126,17 +231,133 @@ Platform_ReadData(uint8_t Address, uint8_t *Data, uint8_t DataLen)
   return 0;
 }
 
-static int8_t
-Platform_CRC(uint16_t Data, uint8_t DataCRC)
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_WriteReadData(void *Context, uint8_t Address,
+                       uint8_t *TxData, uint8_t TxLen,
+                       uint8_t *RxData, uint8_t RxLen)
 {
-  (void)Data;
-  (void)DataCRC;
+  uint8_t DataCounter = 0;
+  int8_t Result;
+
+  (void)Context;
+
+  Result = Platform_Start(Address<<1, TW_MT_SLA_ACK);
+  if (Result != 0)
+    return Result;
+
+  for (DataCounter = 0; DataCounter < TxLen; DataCounter++)
+  {
+    TWDR = TxData[DataCounter];                // set data in data register to sending
+    TWCR = _BV(TWEN) | _BV(TWEA) | _BV(TWINT); // TWI enable *** acknowledge enable
+    if (Platform_Wait() != 0)
+      return -1;
+  }
+
+  // repeated START
+  Result = Platform_Start((Address<<1) | 0x01, TW_MR_SLA_ACK);
+  if (Result != 0)
+    return Result;
+
+  for (DataCounter = 0; DataCounter < RxLen - 1; DataCounter++)
+  {
+    TWCR = _BV(TWEN) | _BV(TWEA) | _BV(TWINT); // TWI enable *** acknowledge enable
+    if (Platform_Wait() != 0) // wait until the process ends
+      return -1;
+    RxData[DataCounter] = TWDR;
+  }
+  TWCR = _BV(TWEN) | _BV(TWINT); // TWI enable
+  if (Platform_Wait() != 0) // wait until the process ends
+    return -1;
+  RxData[DataCounter] = TWDR;
+
+  TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWSTO); // send the STOP mode bit
+
   return 0;
 }
 
+#if (SHT3X_ASYNC == 1)
 static int8_t
-Platform_Delay(uint8_t Delay)
+Platform_TransferAsync(void *Context, uint8_t Address, uint8_t *Data,
+                       uint8_t DataLen, uint8_t Read,
+                       SHT3x_TransferDone_t Done, void *Arg)
+{
+  (void)Context;
+
+  if (AsyncTransfer.Done)
+    return -2;
+
+  AsyncTransfer.Address = Address;
+  AsyncTransfer.Data = Data;
+  AsyncTransfer.DataLen = DataLen;
+  AsyncTransfer.Counter = 0;
+  AsyncTransfer.Read = Read;
+  AsyncTransfer.Arg = Arg;
+  AsyncTransfer.Done = Done;
+
+  TWCR = _BV(TWEN) | _BV(TWSTA) | _BV(TWINT) | _BV(TWIE); // send START
+
+  return 0;
+}
+
+static void
+Platform_FinishAsyncTransfer(int8_t Result)
+{
+  SHT3x_TransferDone_t Done = AsyncTransfer.Done;
+
+  TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWSTO); // send the STOP mode bit
+  AsyncTransfer.Done = 0;
+  if (Done)
+    Done(AsyncTransfer.Arg, Result);
+}
+#endif
+
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_Probe(void *Context, uint8_t Address)
+{
+  int8_t Result;
+
+  (void)Context;
+
+  Result = Platform_Start(Address<<1, TW_MT_SLA_ACK);
+  if (Result != 0)
+    return Result;
+
+  TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWSTO); // send the STOP mode bit
+
+  return 0;
+}
+
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_BusRecovery(void *Context)
 {
+  TWCR = 0; // disable TWI, SCL (PC0) and SDA (PC1) become GPIO
+
+  // Open drain: output low or input (released, pulled up by resistors)
+  PORTC &= ~(_BV(PC0) | _BV(PC1));
+  DDRC &= ~(_BV(PC0) | _BV(PC1));
+
+  // 9 clocks release a slave that holds SDA low
+  for (uint8_t i = 0; i < 9; i++)
+  {
+    sbi(DDRC, PC0);
+    _delay_us(5);
+    cbi(DDRC, PC0);
+    _delay_us(5);
+  }
+
+  // STOP condition: SDA goes high while SCL is high
+  sbi(DDRC, PC1);
+  _delay_us(5);
+  cbi(DDRC, PC1);
+  _delay_us(5);
+
+  return Platform_Init(Context);
+}
+
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_Delay(void *Context, uint8_t Delay)
+{
+  (void)Context;
   for (; Delay > 0; Delay--)
   {
     _delay_ms(1);
@@ -145,6 +366,23 @@ Platform_Delay(uint8_t Delay)
   return 0;
 }
 
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_DelayUs(void *Context, uint32_t Delay)
+{
+  (void)Context;
+  for (; Delay >= 1000; Delay -= 1000)
+  {
+    _delay_ms(1);
+  }
+  // Round up to 10us steps
+  for (; Delay > 0; Delay = (Delay > 10) ? Delay - 10 : 0)
+  {
+    _delay_us(10);
+  }
+
+  return 0;
+}
+
 
 
 /**
@@ -165,6 +403,69 @@ SHT3x_Platform_Init(SHT3x_Handler_t *Handler)
   Handler->PlatformDeInit = Platform_DeInit;
   Handler->PlatformSend = Platform_WriteData;
   Handler->PlatformReceive = Platform_ReadData;
-  Handler->PlatformCRC = Platform_CRC;
+  Handler->PlatformSendReceive = Platform_WriteReadData;
+  Handler->PlatformCRC = NULL; // Use built-in CRC check
+  Handler->PlatformProbe = Platform_Probe;
+  Handler->PlatformBusRecovery = Platform_BusRecovery;
   Handler->PlatformDelay = Platform_Delay;
+  Handler->PlatformDelayUs = Platform_DelayUs;
+#if (SHT3X_ASYNC == 1)
+  Handler->PlatformTransferAsync = Platform_TransferAsync;
+#endif
+}
+
+
+#if (SHT3X_ASYNC == 1)
+/**
+ * @brief  TWI interrupt handler of asynchronous transfers
+ */
+ISR(TWI_vect)
+{
+  switch (TWSR & 0xF8)
+  {
+  case TW_START:
+  case TW_REP_START:
+    TWDR = (AsyncTransfer.Address << 1) | (AsyncTransfer.Read ? 0x01 : 0x00);
+    TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWIE);
+    break;
+
+  case TW_MT_SLA_ACK:
+  case TW_MT_DATA_ACK:
+    if (AsyncTransfer.Counter < AsyncTransfer.DataLen)
+    {
+      TWDR = AsyncTransfer.Data[AsyncTransfer.Counter++];
+      TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWIE);
+    }
+    else
+    {
+      Platform_FinishAsyncTransfer(0);
+    }
+    break;
+
+  case TW_MR_DATA_ACK:
+    AsyncTransfer.Data[AsyncTransfer.Counter++] = TWDR;
+    // fall through
+  case TW_MR_SLA_ACK:
+    if (AsyncTransfer.Counter + 1 < AsyncTransfer.DataLen)
+      TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWIE) | _BV(TWEA); // ACK next byte
+    else
+      TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWIE); // NACK last byte
+    break;
+
+  case TW_MR_DATA_NACK:
+    AsyncTransfer.Data[AsyncTransfer.Counter++] = TWDR;
+    Platform_FinishAsyncTransfer(0);
+    break;
+
+  case TW_MT_SLA_NACK:
+  case TW_MT_DATA_NACK:
+  case TW_MR_SLA_NACK:
+    Platform_FinishAsyncTransfer(-3);
+    break;
+
+  default:
+    Platform_FinishAsyncTransfer(-1);
+    break;
+  }
 }
+#endif
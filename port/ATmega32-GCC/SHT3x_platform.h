@@ -44,6 +44,25 @@ extern "C" {
 /* Functionality Options --------------------------------------------------------*/
 #define SHT3X_I2C_RATE  100000
 
+/**
+ * @brief  Timeout of each bus event in us (at least, it is based on F_CPU). A
+ *         transfer fails if the TWI does not finish in this time. It must be
+ *         longer than the longest clock stretching of the sensor (15ms in
+ *         Single Shot mode with high repeatability).
+ */
+#ifndef SHT3X_TWI_TIMEOUT
+#define SHT3X_TWI_TIMEOUT  20000
+#endif
+
+/**
+ * @brief  Set to 1 to support asynchronous transfers using TWI interrupt. The
+ *         port defines ISR(TWI_vect) in this case, so the application must not
+ *         define it. Global interrupts must be enabled by application.
+ */
+#ifndef SHT3X_ASYNC
+#define SHT3X_ASYNC     0
+#endif
+
 
 
 /**
@@ -54,6 +73,8 @@ extern "C" {
 
 /**
  * @brief  Initialize platform device to communicate SHT3x.
+ * @note   ATmega32 has only one TWI peripheral, so Handler->Context is not used
+ *         and all sensors share the same bus.
  * @param  Handler: Pointer to handler
  * @retval None
  */
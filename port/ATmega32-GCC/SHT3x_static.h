@@ -0,0 +1,106 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_static.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Compile-time platform of SHT3x for ATmega32 (see SHT3X_CONFIG_STATIC_PLATFORM)
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef	_SHT3X_STATIC_H_
+#define _SHT3X_STATIC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/* Exported Constants -----------------------------------------------------------*/
+/**
+ * @brief  Platform functions called directly by the driver
+ * @note   Build all sources with -DSHT3X_CONFIG_STATIC_PLATFORM=1 and this
+ *         folder in the include path. Add -flto to inline them.
+ */
+#define SHT3X_STATIC_INIT           Platform_Init
+#define SHT3X_STATIC_DEINIT         Platform_DeInit
+#define SHT3X_STATIC_SEND           Platform_WriteData
+#define SHT3X_STATIC_RECEIVE        Platform_ReadData
+#define SHT3X_STATIC_SEND_RECEIVE   Platform_WriteReadData
+#define SHT3X_STATIC_DELAY          Platform_Delay
+#define SHT3X_STATIC_DELAY_US       Platform_DelayUs
+#define SHT3X_STATIC_PROBE          Platform_Probe
+#define SHT3X_STATIC_BUS_RECOVERY   Platform_BusRecovery
+
+
+
+/**
+ ==================================================================================
+                               ##### Functions #####                               
+ ==================================================================================
+ */
+
+/**
+ * @brief  Platform functions of SHT3x_platform.c (not static in this mode)
+ */
+int8_t
+Platform_Init(void *Context);
+
+int8_t
+Platform_DeInit(void *Context);
+
+int8_t
+Platform_WriteData(void *Context, uint8_t Address, uint8_t *Data, uint8_t DataLen);
+
+int8_t
+Platform_ReadData(void *Context, uint8_t Address, uint8_t *Data, uint8_t DataLen);
+
+int8_t
+Platform_WriteReadData(void *Context, uint8_t Address,
+                       uint8_t *TxData, uint8_t TxLen,
+                       uint8_t *RxData, uint8_t RxLen);
+
+int8_t
+Platform_Delay(void *Context, uint8_t Delay);
+
+int8_t
+Platform_DelayUs(void *Context, uint32_t Delay);
+
+int8_t
+Platform_Probe(void *Context, uint8_t Address);
+
+int8_t
+Platform_BusRecovery(void *Context);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _SHT3X_STATIC_H_
@@ -0,0 +1,347 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_platform.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  SHT3x series driver platform dependent part (ESP-IDF i2c_master driver)
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "SHT3x_platform.h"
+#include "sdkconfig.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+
+
+/* Private Constants ------------------------------------------------------------*/
+/**
+ * @brief  I2C addresses of the sensor (a device handle is created for each)
+ */
+static const uint8_t Platform_Address[2] = {0x44, 0x45};
+
+
+
+/* Private Variables ------------------------------------------------------------*/
+static SHT3x_PlatformBus_t DefaultBus =
+{
+  .I2CNum = SHT3X_I2C_NUM,
+  .Rate = SHT3X_I2C_RATE,
+  .SCL = SHT3X_SCL_GPIO,
+  .SDA = SHT3X_SDA_GPIO,
+};
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static SHT3x_PlatformBus_t *
+Platform_GetBus(void *Context)
+{
+  return Context ? (SHT3x_PlatformBus_t *)Context : &DefaultBus;
+}
+
+
+static i2c_master_dev_handle_t
+Platform_GetDevice(SHT3x_PlatformBus_t *Bus, uint8_t Address)
+{
+  uint8_t i;
+
+  for (i = 0; i < sizeof(Platform_Address); i++)
+  {
+    if (Platform_Address[i] == Address)
+      return Bus->Device[i];
+  }
+
+  return NULL;
+}
+
+
+static void
+Platform_FreeBus(SHT3x_PlatformBus_t *Bus)
+{
+  uint8_t i;
+
+  for (i = 0; i < sizeof(Platform_Address); i++)
+  {
+    if (Bus->Device[i])
+      i2c_master_bus_rm_device(Bus->Device[i]);
+    Bus->Device[i] = NULL;
+  }
+
+  if (Bus->OwnBus && Bus->BusHandle)
+  {
+    i2c_del_master_bus(Bus->BusHandle);
+    Bus->BusHandle = NULL;
+    gpio_reset_pin(Bus->SDA);
+    gpio_reset_pin(Bus->SCL);
+  }
+  Bus->OwnBus = 0;
+}
+
+
+static int
+Platform_GetTimeout(SHT3x_PlatformBus_t *Bus)
+{
+  return (int)(Bus->Timeout ? Bus->Timeout : SHT3X_I2C_TIMEOUT);
+}
+
+
+static int8_t
+Platform_Result(esp_err_t Err)
+{
+  if (Err == ESP_OK)
+    return 0;
+
+  // The driver reports ESP_ERR_INVALID_STATE (ESP_FAIL in some versions) if
+  // the slave doesn't ACK. Timeouts and other errors are bus failures.
+  if (Err == ESP_ERR_INVALID_STATE || Err == ESP_FAIL)
+    return -3;
+
+  return -1;
+}
+
+
+static int8_t
+Platform_Init(void *Context)
+{
+  SHT3x_PlatformBus_t *Bus = Platform_GetBus(Context);
+  i2c_master_bus_config_t BusConfig = {0};
+  i2c_device_config_t DeviceConfig = {0};
+  uint8_t i;
+
+  if (Bus->RefCount)
+  {
+    Bus->RefCount++;
+    return 0;
+  }
+
+  if (!Bus->BusHandle)
+  {
+    BusConfig.i2c_port = Bus->I2CNum;
+    BusConfig.sda_io_num = Bus->SDA;
+    BusConfig.scl_io_num = Bus->SCL;
+    BusConfig.clk_source = I2C_CLK_SRC_DEFAULT;
+    BusConfig.glitch_ignore_cnt = 7;
+    BusConfig.flags.enable_internal_pullup = 0;
+    if (i2c_new_master_bus(&BusConfig, &Bus->BusHandle) != ESP_OK)
+    {
+      Bus->BusHandle = NULL;
+      return -1;
+    }
+    Bus->OwnBus = 1;
+  }
+
+  // Device handles are created once, so transfers need no allocation
+  DeviceConfig.dev_addr_length = I2C_ADDR_BIT_LEN_7;
+  DeviceConfig.scl_speed_hz = Bus->Rate;
+  for (i = 0; i < sizeof(Platform_Address); i++)
+  {
+    DeviceConfig.device_address = Platform_Address[i];
+    if (i2c_master_bus_add_device(Bus->BusHandle, &DeviceConfig,
+                                  &Bus->Device[i]) != ESP_OK)
+    {
+      Bus->Device[i] = NULL;
+      Platform_FreeBus(Bus);
+      return -1;
+    }
+  }
+
+  Bus->RefCount = 1;
+  return 0;
+}
+
+
+static int8_t
+Platform_DeInit(void *Context)
+{
+  SHT3x_PlatformBus_t *Bus = Platform_GetBus(Context);
+
+  if (!Bus->RefCount)
+    return 0;
+
+  if (--Bus->RefCount)
+    return 0;
+
+  Platform_FreeBus(Bus);
+
+  return 0;
+}
+
+
+static int8_t
+Platform_WriteData(void *Context, uint8_t Address, uint8_t *Data, uint8_t DataLen)
+{
+  SHT3x_PlatformBus_t *Bus = Platform_GetBus(Context);
+  i2c_master_dev_handle_t Device = Platform_GetDevice(Bus, Address);
+
+  if (!Device)
+    return -1;
+
+  return Platform_Result(i2c_master_transmit(Device, Data, DataLen,
+                                             Platform_GetTimeout(Bus)));
+}
+
+
+static int8_t
+Platform_ReadData(void *Context, uint8_t Address, uint8_t *Data, uint8_t DataLen)
+{
+  SHT3x_PlatformBus_t *Bus = Platform_GetBus(Context);
+  i2c_master_dev_handle_t Device = Platform_GetDevice(Bus, Address);
+
+  if (!Device)
+    return -1;
+
+  return Platform_Result(i2c_master_receive(Device, Data, DataLen,
+                                            Platform_GetTimeout(Bus)));
+}
+
+
+static int8_t
+Platform_WriteReadData(void *Context, uint8_t Address,
+                       uint8_t *TxData, uint8_t TxLen,
+                       uint8_t *RxData, uint8_t RxLen)
+{
+  SHT3x_PlatformBus_t *Bus = Platform_GetBus(Context);
+  i2c_master_dev_handle_t Device = Platform_GetDevice(Bus, Address);
+
+  if (!Device)
+    return -1;
+
+  return Platform_Result(i2c_master_transmit_receive(Device, TxData, TxLen,
+                                                     RxData, RxLen,
+                                                     Platform_GetTimeout(Bus)));
+}
+
+
+static int8_t
+Platform_Probe(void *Context, uint8_t Address)
+{
+  SHT3x_PlatformBus_t *Bus = Platform_GetBus(Context);
+  esp_err_t Err;
+
+  if (!Bus->BusHandle)
+    return -1;
+
+  Err = i2c_master_probe(Bus->BusHandle, Address, SHT3X_I2C_PROBE_TIMEOUT);
+  if (Err == ESP_OK)
+    return 0;
+  if (Err == ESP_ERR_NOT_FOUND)
+    return -3;
+
+  return -1;
+}
+
+
+static int8_t
+Platform_BusRecovery(void *Context)
+{
+  SHT3x_PlatformBus_t *Bus = Platform_GetBus(Context);
+
+  if (!Bus->BusHandle)
+    return -1;
+
+  // The driver sends 9 clocks and a STOP condition
+  if (i2c_master_bus_reset(Bus->BusHandle) != ESP_OK)
+    return -1;
+
+  return 0;
+}
+
+
+static int8_t
+Platform_Delay(void *Context, uint8_t Delay)
+{
+  (void)Context;
+  // Round up, otherwise delays shorter than one tick would not wait at all
+  vTaskDelay((Delay + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS);
+
+  return 0;
+}
+
+
+static int8_t
+Platform_DelayUs(void *Context, uint32_t Delay)
+{
+  int64_t Deadline = esp_timer_get_time() + Delay;
+  int64_t Remaining = Delay;
+  const int64_t Tick = (int64_t)portTICK_PERIOD_MS * 1000;
+
+  (void)Context;
+  // Sleep whole ticks and busy wait only for the rest (less than one tick)
+  while (Remaining >= Tick)
+  {
+    vTaskDelay(Remaining / Tick);
+    Remaining = Deadline - esp_timer_get_time();
+  }
+  if (Remaining > 0)
+    esp_rom_delay_us((uint32_t)Remaining);
+
+  return 0;
+}
+
+
+static uint32_t
+Platform_GetTime(void *Context)
+{
+  (void)Context;
+  return (uint32_t)esp_timer_get_time();
+}
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####                           
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize platform device to communicate SHT3x.
+ * @param  Handler: Pointer to handler
+ * @retval None
+ */
+void
+SHT3x_Platform_Init(SHT3x_Handler_t *Handler)
+{
+  Handler->PlatformInit = Platform_Init;
+  Handler->PlatformDeInit = Platform_DeInit;
+  Handler->PlatformSend = Platform_WriteData;
+  Handler->PlatformReceive = Platform_ReadData;
+  Handler->PlatformSendReceive = Platform_WriteReadData;
+  Handler->PlatformCRC = NULL; // Use built-in CRC check
+  Handler->PlatformProbe = Platform_Probe;
+  Handler->PlatformBusRecovery = Platform_BusRecovery;
+  Handler->PlatformDelay = Platform_Delay;
+  Handler->PlatformDelayUs = Platform_DelayUs;
+  Handler->PlatformGetTime = Platform_GetTime;
+}
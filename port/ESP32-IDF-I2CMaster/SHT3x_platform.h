@@ -0,0 +1,114 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_platform.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  SHT3x series driver platform dependent part (ESP-IDF i2c_master driver)
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef	_SHT3X_PLATFORM_H_
+#define _SHT3X_PLATFORM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "SHT3x.h"
+#include "driver/i2c_master.h"
+#include "driver/gpio.h"
+
+
+/* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Default bus configuration (used when Handler->Context is NULL)
+ */
+#define SHT3X_I2C_NUM   I2C_NUM_1
+#define SHT3X_I2C_RATE  100000
+#define SHT3X_SCL_GPIO  GPIO_NUM_13
+#define SHT3X_SDA_GPIO  GPIO_NUM_14
+
+/**
+ * @brief  Default timeout of each I2C transfer (used when Timeout of the bus
+ *         is 0) and timeout of address probe in milliseconds
+ */
+#define SHT3X_I2C_TIMEOUT       100
+#define SHT3X_I2C_PROBE_TIMEOUT 10
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  I2C bus data type
+ * @note   Set Handler->Context to a pointer of this type to use another bus.
+ *         Sensors on the same bus must share the same object.
+ * @note   To share a bus that is already created by the application with
+ *         other drivers, set BusHandle before initializing the sensors. In
+ *         this case I2CNum, SCL and SDA are ignored and the bus is never
+ *         deleted by the port.
+ */
+typedef struct SHT3x_PlatformBus_s
+{
+  i2c_port_num_t I2CNum;
+  uint32_t Rate;
+  gpio_num_t SCL;
+  gpio_num_t SDA;
+  i2c_master_bus_handle_t BusHandle;
+  uint32_t Timeout;   // Transfer timeout in ms (0: SHT3X_I2C_TIMEOUT)
+
+  // Private data. Do not change it.
+  uint8_t RefCount;
+  uint8_t OwnBus;
+  i2c_master_dev_handle_t Device[2];
+} SHT3x_PlatformBus_t;
+
+
+
+/**
+ ==================================================================================
+                             ##### Functions #####                                 
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize platform device to communicate SHT3x.
+ * @note   Handler->Context is not changed. If it is NULL, the default bus is
+ *         used.
+ * @param  Handler: Pointer to handler
+ * @retval None
+ */
+void
+SHT3x_Platform_Init(SHT3x_Handler_t *Handler);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif //! _SHT3X_PLATFORM_H_
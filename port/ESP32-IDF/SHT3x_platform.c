@@ -32,8 +32,21 @@
 #include "SHT3x_platform.h"
 #include "sdkconfig.h"
 #include "esp_system.h"
-#include "driver/i2c.h"
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+
+
+/* Private Variables ------------------------------------------------------------*/
+static SHT3x_PlatformBus_t DefaultBus =
+{
+  .I2CNum = SHT3X_I2C_NUM,
+  .Rate = SHT3X_I2C_RATE,
+  .SCL = SHT3X_SCL_GPIO,
+  .SDA = SHT3X_SDA_GPIO,
+};
 
 
 
@@ -43,21 +56,49 @@
  ==================================================================================
  */
 
+static SHT3x_PlatformBus_t *
+Platform_GetBus(void *Context)
+{
+  return Context ? (SHT3x_PlatformBus_t *)Context : &DefaultBus;
+}
+
+
 static int8_t
-Platform_Init(void)
+Platform_Result(esp_err_t Err)
+{
+  if (Err == ESP_OK)
+    return 0;
+
+  // The driver reports ESP_FAIL if the slave doesn't ACK
+  if (Err == ESP_FAIL)
+    return -3;
+
+  return -1;
+}
+
+
+static TickType_t
+Platform_GetTimeout(SHT3x_PlatformBus_t *Bus)
+{
+  return pdMS_TO_TICKS(Bus->Timeout ? Bus->Timeout : SHT3X_I2C_TIMEOUT);
+}
+
+
+static int8_t
+Platform_Install(SHT3x_PlatformBus_t *Bus)
 {
   i2c_config_t conf = {0};
 
   conf.mode = I2C_MODE_MASTER;
-  conf.sda_io_num = SHT3X_SDA_GPIO;
+  conf.sda_io_num = Bus->SDA;
   conf.sda_pullup_en = GPIO_PULLUP_DISABLE;
-  conf.scl_io_num = SHT3X_SCL_GPIO;
+  conf.scl_io_num = Bus->SCL;
   conf.scl_pullup_en = GPIO_PULLUP_DISABLE;
-  conf.master.clk_speed = SHT3X_I2C_RATE;
-  if (i2c_param_config(SHT3X_I2C_NUM, &conf) != ESP_OK)
+  conf.master.clk_speed = Bus->Rate;
+  if (i2c_param_config(Bus->I2CNum, &conf) != ESP_OK)
     return -1;
 
-  if (i2c_driver_install(SHT3X_I2C_NUM, conf.mode, 0, 0, 0) != ESP_OK)
+  if (i2c_driver_install(Bus->I2CNum, conf.mode, 0, 0, 0) != ESP_OK)
     return -2;
 
   return 0;
@@ -65,20 +106,51 @@ Platform_Init(void)
 
 
 static int8_t
-Platform_DeInit(void)
+Platform_Init(void *Context)
+{
+  SHT3x_PlatformBus_t *Bus = Platform_GetBus(Context);
+  int8_t Result;
+
+  if (Bus->RefCount)
+  {
+    Bus->RefCount++;
+    return 0;
+  }
+
+  Result = Platform_Install(Bus);
+  if (Result != 0)
+    return Result;
+
+  Bus->RefCount = 1;
+  return 0;
+}
+
+
+static int8_t
+Platform_DeInit(void *Context)
 {
-  i2c_driver_delete(SHT3X_I2C_NUM);
-  gpio_reset_pin(SHT3X_SDA_GPIO);
-  gpio_reset_pin(SHT3X_SCL_GPIO);
+  SHT3x_PlatformBus_t *Bus = Platform_GetBus(Context);
+
+  if (!Bus->RefCount)
+    return 0;
+
+  if (--Bus->RefCount)
+    return 0;
+
+  i2c_driver_delete(Bus->I2CNum);
+  gpio_reset_pin(Bus->SDA);
+  gpio_reset_pin(Bus->SCL);
 
   return 0;
 }
 
 
 static int8_t
-Platform_WriteData(uint8_t Address, uint8_t *Data, uint8_t DataLen)
+Platform_WriteData(void *Context, uint8_t Address, uint8_t *Data, uint8_t DataLen)
 {
+  SHT3x_PlatformBus_t *Bus = Platform_GetBus(Context);
   i2c_cmd_handle_t SHT3x_i2c_cmd_handle = 0;
+  esp_err_t Err;
 
   Address <<= 1;
   Address &= 0xFE;
@@ -88,21 +160,19 @@ Platform_WriteData(uint8_t Address, uint8_t *Data, uint8_t DataLen)
   i2c_master_write(SHT3x_i2c_cmd_handle, &Address, 1, 1);
   i2c_master_write(SHT3x_i2c_cmd_handle, Data, DataLen, 1);
   i2c_master_stop(SHT3x_i2c_cmd_handle);
-  if (i2c_master_cmd_begin(SHT3X_I2C_NUM, SHT3x_i2c_cmd_handle, 1000 / portTICK_PERIOD_MS) != ESP_OK)
-  {
-    i2c_cmd_link_delete(SHT3x_i2c_cmd_handle);
-    return -1;
-  }
-
+  Err = i2c_master_cmd_begin(Bus->I2CNum, SHT3x_i2c_cmd_handle,
+                             Platform_GetTimeout(Bus));
   i2c_cmd_link_delete(SHT3x_i2c_cmd_handle);
-  return 0;
+  return Platform_Result(Err);
 }
 
 
 static int8_t
-Platform_ReadData(uint8_t Address, uint8_t *Data, uint8_t DataLen)
+Platform_ReadData(void *Context, uint8_t Address, uint8_t *Data, uint8_t DataLen)
 {
+  SHT3x_PlatformBus_t *Bus = Platform_GetBus(Context);
   i2c_cmd_handle_t SHT3x_i2c_cmd_handle = 0;
+  esp_err_t Err;
 
   Address <<= 1;
   Address |= 0x01;
@@ -112,32 +182,130 @@ Platform_ReadData(uint8_t Address, uint8_t *Data, uint8_t DataLen)
   i2c_master_write(SHT3x_i2c_cmd_handle, &Address, 1, 1);
   i2c_master_read(SHT3x_i2c_cmd_handle, Data, DataLen, I2C_MASTER_LAST_NACK);
   i2c_master_stop(SHT3x_i2c_cmd_handle);
-  if (i2c_master_cmd_begin(SHT3X_I2C_NUM, SHT3x_i2c_cmd_handle, 1000 / portTICK_PERIOD_MS) != ESP_OK)
-  {
-    i2c_cmd_link_delete(SHT3x_i2c_cmd_handle);
+  Err = i2c_master_cmd_begin(Bus->I2CNum, SHT3x_i2c_cmd_handle,
+                             Platform_GetTimeout(Bus));
+  i2c_cmd_link_delete(SHT3x_i2c_cmd_handle);
+  return Platform_Result(Err);
+}
+
+static int8_t
+Platform_WriteReadData(void *Context, uint8_t Address,
+                       uint8_t *TxData, uint8_t TxLen,
+                       uint8_t *RxData, uint8_t RxLen)
+{
+  SHT3x_PlatformBus_t *Bus = Platform_GetBus(Context);
+  i2c_cmd_handle_t SHT3x_i2c_cmd_handle = 0;
+  esp_err_t Err;
+  uint8_t AddressW = (Address << 1) & 0xFE;
+  uint8_t AddressR = (Address << 1) | 0x01;
+
+  SHT3x_i2c_cmd_handle = i2c_cmd_link_create();
+  i2c_master_start(SHT3x_i2c_cmd_handle);
+  i2c_master_write(SHT3x_i2c_cmd_handle, &AddressW, 1, 1);
+  i2c_master_write(SHT3x_i2c_cmd_handle, TxData, TxLen, 1);
+  i2c_master_start(SHT3x_i2c_cmd_handle);
+  i2c_master_write(SHT3x_i2c_cmd_handle, &AddressR, 1, 1);
+  i2c_master_read(SHT3x_i2c_cmd_handle, RxData, RxLen, I2C_MASTER_LAST_NACK);
+  i2c_master_stop(SHT3x_i2c_cmd_handle);
+  Err = i2c_master_cmd_begin(Bus->I2CNum, SHT3x_i2c_cmd_handle,
+                             Platform_GetTimeout(Bus));
+  i2c_cmd_link_delete(SHT3x_i2c_cmd_handle);
+  return Platform_Result(Err);
+}
+
+static int8_t
+Platform_Probe(void *Context, uint8_t Address)
+{
+  SHT3x_PlatformBus_t *Bus = Platform_GetBus(Context);
+  i2c_cmd_handle_t SHT3x_i2c_cmd_handle = 0;
+  esp_err_t Err;
+
+  Address <<= 1;
+  Address &= 0xFE;
+
+  SHT3x_i2c_cmd_handle = i2c_cmd_link_create();
+  i2c_master_start(SHT3x_i2c_cmd_handle);
+  i2c_master_write(SHT3x_i2c_cmd_handle, &Address, 1, 1);
+  i2c_master_stop(SHT3x_i2c_cmd_handle);
+  Err = i2c_master_cmd_begin(Bus->I2CNum, SHT3x_i2c_cmd_handle,
+                             pdMS_TO_TICKS(SHT3X_I2C_PROBE_TIMEOUT));
+  i2c_cmd_link_delete(SHT3x_i2c_cmd_handle);
+  return Platform_Result(Err);
+}
+
+static int8_t
+Platform_BusRecovery(void *Context)
+{
+  SHT3x_PlatformBus_t *Bus = Platform_GetBus(Context);
+
+  if (!Bus->RefCount)
     return -1;
+
+  i2c_driver_delete(Bus->I2CNum);
+
+  // Detach the pins from the I2C peripheral
+  gpio_reset_pin(Bus->SCL);
+  gpio_reset_pin(Bus->SDA);
+  gpio_set_level(Bus->SCL, 1);
+  gpio_set_level(Bus->SDA, 1);
+  gpio_set_direction(Bus->SCL, GPIO_MODE_INPUT_OUTPUT_OD);
+  gpio_set_direction(Bus->SDA, GPIO_MODE_INPUT_OUTPUT_OD);
+
+  // 9 clocks release a slave that holds SDA low
+  for (uint8_t i = 0; i < 9; i++)
+  {
+    gpio_set_level(Bus->SCL, 0);
+    esp_rom_delay_us(5);
+    gpio_set_level(Bus->SCL, 1);
+    esp_rom_delay_us(5);
   }
 
-  i2c_cmd_link_delete(SHT3x_i2c_cmd_handle);
-  return 0;
+  // STOP condition: SDA goes high while SCL is high
+  gpio_set_level(Bus->SDA, 0);
+  esp_rom_delay_us(5);
+  gpio_set_level(Bus->SDA, 1);
+  esp_rom_delay_us(5);
+
+  return Platform_Install(Bus);
 }
 
 static int8_t
-Platform_CRC(uint16_t Data, uint8_t DataCRC)
+Platform_Delay(void *Context, uint8_t Delay)
 {
-  (void)Data;
-  (void)DataCRC;
+  (void)Context;
+  // Round up, otherwise delays shorter than one tick would not wait at all
+  vTaskDelay((Delay + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS);
+
   return 0;
 }
 
 static int8_t
-Platform_Delay(uint8_t Delay)
+Platform_DelayUs(void *Context, uint32_t Delay)
 {
-  vTaskDelay(Delay / portTICK_PERIOD_MS);
+  int64_t Deadline = esp_timer_get_time() + Delay;
+  int64_t Remaining = Delay;
+  const int64_t Tick = (int64_t)portTICK_PERIOD_MS * 1000;
+
+  (void)Context;
+  // Sleep whole ticks and busy wait only for the rest (less than one tick)
+  while (Remaining >= Tick)
+  {
+    vTaskDelay(Remaining / Tick);
+    Remaining = Deadline - esp_timer_get_time();
+  }
+  if (Remaining > 0)
+    esp_rom_delay_us((uint32_t)Remaining);
 
   return 0;
 }
 
+static uint32_t
+Platform_GetTime(void *Context)
+{
+  (void)Context;
+  return (uint32_t)esp_timer_get_time();
+}
+
 
 /**
  ==================================================================================
@@ -157,6 +325,11 @@ SHT3x_Platform_Init(SHT3x_Handler_t *Handler)
   Handler->PlatformDeInit = Platform_DeInit;
   Handler->PlatformSend = Platform_WriteData;
   Handler->PlatformReceive = Platform_ReadData;
-  Handler->PlatformCRC = Platform_CRC;
+  Handler->PlatformSendReceive = Platform_WriteReadData;
+  Handler->PlatformCRC = NULL; // Use built-in CRC check
+  Handler->PlatformProbe = Platform_Probe;
+  Handler->PlatformBusRecovery = Platform_BusRecovery;
   Handler->PlatformDelay = Platform_Delay;
+  Handler->PlatformDelayUs = Platform_DelayUs;
+  Handler->PlatformGetTime = Platform_GetTime;
 }
@@ -39,14 +39,46 @@ extern "C" {
 
 /* Includes ---------------------------------------------------------------------*/
 #include "SHT3x.h"
+#include "driver/i2c.h"
+#include "driver/gpio.h"
 
 
 /* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Default bus configuration (used when Handler->Context is NULL)
+ */
 #define SHT3X_I2C_NUM   I2C_NUM_1
 #define SHT3X_I2C_RATE  100000
 #define SHT3X_SCL_GPIO  GPIO_NUM_13
 #define SHT3X_SDA_GPIO  GPIO_NUM_14
 
+/**
+ * @brief  Default timeout of each I2C transfer (used when Timeout of the bus
+ *         is 0) and timeout of address probe in milliseconds
+ */
+#define SHT3X_I2C_TIMEOUT       100
+#define SHT3X_I2C_PROBE_TIMEOUT 10
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  I2C bus data type
+ * @note   Set Handler->Context to a pointer of this type to use another bus.
+ *         Sensors on the same bus must share the same object.
+ */
+typedef struct SHT3x_PlatformBus_s
+{
+  i2c_port_t I2CNum;
+  uint32_t Rate;
+  gpio_num_t SCL;
+  gpio_num_t SDA;
+  uint32_t Timeout;   // Transfer timeout in ms (0: SHT3X_I2C_TIMEOUT)
+
+  // Private data. Do not change it.
+  uint8_t RefCount;
+} SHT3x_PlatformBus_t;
+
 
 
 /**
@@ -57,6 +89,8 @@ extern "C" {
 
 /**
  * @brief  Initialize platform device to communicate SHT3x.
+ * @note   Handler->Context is not changed. If it is NULL, the default bus is
+ *         used.
  * @param  Handler: Pointer to handler
  * @retval None
  */
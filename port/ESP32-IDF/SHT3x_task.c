@@ -0,0 +1,363 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_task.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  FreeRTOS sensor task for SHT3x driver (ESP32-IDF)
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "SHT3x_task.h"
+#include "esp_system.h"
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static void
+Task_TimerCallback(void *Arg)
+{
+  SHT3x_Task_t *Task = (SHT3x_Task_t *)Arg;
+
+  xTaskNotifyGive(Task->TaskHandle);
+}
+
+
+/**
+ * @brief  Block the task for Time microseconds
+ * @note   esp_timer is used so waits shorter than one RTOS tick are not
+ *         rounded. SHT3x_TaskStop() wakes the task early.
+ */
+static void
+Task_Wait(SHT3x_Task_t *Task, uint64_t Time)
+{
+  if (!Time || Task->Stop)
+    return;
+
+  if (esp_timer_start_once(Task->Timer, Time) != ESP_OK)
+  {
+    vTaskDelay(1);
+    return;
+  }
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  esp_timer_stop(Task->Timer);
+}
+
+
+static void
+Task_Publish(SHT3x_Task_t *Task, uint8_t Index,
+             SHT3x_Result_t Result, SHT3x_Sample_t *Sample)
+{
+  SHT3x_TaskMessage_t Message = {0};
+
+  Message.Index = Index;
+  Message.Result = Result;
+  Message.Timestamp = esp_timer_get_time();
+  if (Sample)
+    Message.Sample = *Sample;
+
+  if (xQueueSend(Task->Queue, &Message, 0) != pdTRUE)
+    Task->Dropped++;
+}
+
+
+static SHT3x_Result_t
+Task_Start(SHT3x_Task_t *Task, SHT3x_Handler_t *Handler)
+{
+  SHT3x_Result_t Result;
+
+  xSemaphoreTake(Task->BusMutex, portMAX_DELAY);
+  Result = SHT3x_StartMeasurement(Handler);
+  xSemaphoreGive(Task->BusMutex);
+
+  return Result;
+}
+
+
+static SHT3x_Result_t
+Task_Fetch(SHT3x_Task_t *Task, SHT3x_Handler_t *Handler, SHT3x_Sample_t *Sample)
+{
+  SHT3x_Result_t Result;
+
+  xSemaphoreTake(Task->BusMutex, portMAX_DELAY);
+  Result = SHT3x_FetchSample(Handler, Sample);
+  xSemaphoreGive(Task->BusMutex);
+
+  return Result;
+}
+
+
+static void
+Task_Main(void *Param)
+{
+  SHT3x_Task_t *Task = (SHT3x_Task_t *)Param;
+  SHT3x_Handler_t *Handler;
+  SHT3x_Sample_t Sample;
+  SHT3x_Result_t Result;
+  int64_t NextRun = esp_timer_get_time();
+  int64_t Now;
+  uint32_t WaitTime;
+  uint8_t Retry;
+  uint8_t i;
+
+  while (!Task->Stop)
+  {
+    // Trigger all Single Shot sensors back-to-back
+    WaitTime = 0;
+    for (i = 0; i < Task->Count; i++)
+    {
+      Handler = &Task->Handlers[i];
+      if (Handler->Mode != SHT3x_MODE_SINGLESHOT)
+        continue;
+
+      Result = Task_Start(Task, Handler);
+      if (Result != SHT3x_OK)
+      {
+        Task_Publish(Task, i, Result, NULL);
+        continue;
+      }
+
+      if (SHT3x_MeasurementDueIn(Handler) > WaitTime)
+        WaitTime = SHT3x_MeasurementDueIn(Handler);
+    }
+
+    Task_Wait(Task, WaitTime);
+
+    for (i = 0; i < Task->Count && !Task->Stop; i++)
+    {
+      Handler = &Task->Handlers[i];
+      if (Handler->Mode == SHT3x_MODE_SINGLESHOT)
+      {
+        // No measurement is pending (it was not started)
+        if (SHT3x_IsReady(Handler) == SHT3x_INVALID_PARAM)
+          continue;
+
+        Result = Task_Fetch(Task, Handler, &Sample);
+        for (Retry = 0;
+             Result == SHT3x_NO_DATA && Retry < SHT3X_TASK_FETCH_RETRY;
+             Retry++)
+        {
+          Task_Wait(Task, 1000);
+          Result = Task_Fetch(Task, Handler, &Sample);
+        }
+
+        if (Result == SHT3x_NO_DATA)
+          Result = SHT3x_FAIL;
+      }
+      else
+      {
+        Result = Task_Fetch(Task, Handler, &Sample);
+        if (Result == SHT3x_NO_DATA)
+          continue; // No new sample since the last fetch
+      }
+
+      Task_Publish(Task, i, Result, (Result == SHT3x_OK) ? &Sample : NULL);
+    }
+
+    // Keep a fixed rate. Missed intervals are skipped.
+    NextRun += (int64_t)Task->Interval * 1000;
+    Now = esp_timer_get_time();
+    if (NextRun < Now)
+      NextRun = Now;
+    Task_Wait(Task, (uint64_t)(NextRun - Now));
+  }
+
+  Task->TaskHandle = NULL;
+  vTaskDelete(NULL);
+}
+
+
+
+/**
+ ==================================================================================
+                             ##### Task Functions #####                            
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize a sensor task over an array of handlers
+ * @note   Other code that accesses the same I2C bus (for example another
+ *         sensor task) must take Task->BusMutex while using the bus.
+ *
+ * @param  Task: Pointer to task
+ * @param  Handlers: Pointer to array of initialized handlers
+ * @param  Count: Number of handlers
+ * @param  Interval: Sampling interval in milliseconds
+ * @param  QueueLength: Number of messages the queue can hold
+ * @param  BusMutex: Mutex of the bus. If it is NULL a new mutex is created.
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to create the queue, mutex or timer.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_TaskInit(SHT3x_Task_t *Task, SHT3x_Handler_t *Handlers, uint8_t Count,
+               uint32_t Interval, uint8_t QueueLength,
+               SemaphoreHandle_t BusMutex)
+{
+  esp_timer_create_args_t TimerArgs = {0};
+
+  if (!Handlers || !Count || !QueueLength)
+    return SHT3x_INVALID_PARAM;
+
+  Task->Handlers = Handlers;
+  Task->Count = Count;
+  Task->Interval = Interval;
+  Task->TaskHandle = NULL;
+  Task->Dropped = 0;
+  Task->Stop = 0;
+  Task->Timer = NULL;
+  Task->BusMutex = BusMutex;
+  Task->OwnMutex = 0;
+
+  Task->Queue = xQueueCreate(QueueLength, sizeof(SHT3x_TaskMessage_t));
+  if (!Task->Queue)
+    return SHT3x_FAIL;
+
+  if (!Task->BusMutex)
+  {
+    Task->BusMutex = xSemaphoreCreateMutex();
+    Task->OwnMutex = 1;
+    if (!Task->BusMutex)
+    {
+      SHT3x_TaskDeInit(Task);
+      return SHT3x_FAIL;
+    }
+  }
+
+  TimerArgs.callback = Task_TimerCallback;
+  TimerArgs.arg = Task;
+  TimerArgs.name = "SHT3x";
+  if (esp_timer_create(&TimerArgs, &Task->Timer) != ESP_OK)
+  {
+    Task->Timer = NULL;
+    SHT3x_TaskDeInit(Task);
+    return SHT3x_FAIL;
+  }
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Free the resources of a stopped sensor task
+ * @param  Task: Pointer to task
+ * @retval None
+ */
+void
+SHT3x_TaskDeInit(SHT3x_Task_t *Task)
+{
+  if (Task->Timer)
+    esp_timer_delete(Task->Timer);
+  Task->Timer = NULL;
+
+  if (Task->Queue)
+    vQueueDelete(Task->Queue);
+  Task->Queue = NULL;
+
+  if (Task->OwnMutex && Task->BusMutex)
+    vSemaphoreDelete(Task->BusMutex);
+  Task->BusMutex = NULL;
+  Task->OwnMutex = 0;
+}
+
+
+/**
+ * @brief  Create the FreeRTOS task and start sampling
+ * @param  Task: Pointer to task
+ * @param  Name: Name of the FreeRTOS task
+ * @param  StackSize: Stack size of the FreeRTOS task
+ * @param  Priority: Priority of the FreeRTOS task
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to create the task or it is already running.
+ */
+SHT3x_Result_t
+SHT3x_TaskStart(SHT3x_Task_t *Task, const char *Name,
+                uint32_t StackSize, UBaseType_t Priority)
+{
+  if (Task->TaskHandle || !Task->Queue)
+    return SHT3x_FAIL;
+
+  Task->Stop = 0;
+  if (xTaskCreate(Task_Main, Name, StackSize, Task,
+                  Priority, &Task->TaskHandle) != pdPASS)
+  {
+    Task->TaskHandle = NULL;
+    return SHT3x_FAIL;
+  }
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Ask the sensor task to stop
+ * @note   The task finishes its current transfer and deletes itself.
+ *         SHT3x_TaskIsRunning() can be used to wait for it.
+ *
+ * @param  Task: Pointer to task
+ * @retval None
+ */
+void
+SHT3x_TaskStop(SHT3x_Task_t *Task)
+{
+  TaskHandle_t TaskHandle = Task->TaskHandle;
+
+  Task->Stop = 1;
+  if (TaskHandle)
+    xTaskNotifyGive(TaskHandle);
+}
+
+
+/**
+ * @brief  Check if the sensor task is running
+ * @param  Task: Pointer to task
+ * @retval 1 if the task is running, 0 otherwise
+ */
+uint8_t
+SHT3x_TaskIsRunning(SHT3x_Task_t *Task)
+{
+  return Task->TaskHandle ? 1 : 0;
+}
+
+
+/**
+ * @brief  Number of messages dropped because the queue was full
+ * @param  Task: Pointer to task
+ * @retval Number of dropped messages
+ */
+uint32_t
+SHT3x_TaskGetDropped(SHT3x_Task_t *Task)
+{
+  return Task->Dropped;
+}
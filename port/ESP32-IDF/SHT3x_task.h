@@ -0,0 +1,185 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_task.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  FreeRTOS sensor task for SHT3x driver (ESP32-IDF)
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef	_SHT3X_TASK_H_
+#define _SHT3X_TASK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "SHT3x.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+
+
+/* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Number of 1ms retries when a sensor is not ready to be fetched yet
+ */
+#define SHT3X_TASK_FETCH_RETRY  5
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Queue message data type
+ */
+typedef struct SHT3x_TaskMessage_s
+{
+  uint8_t Index;            // Index of handler in the handlers array
+  SHT3x_Result_t Result;    // Result of reading. Sample is valid on SHT3x_OK
+  int64_t Timestamp;        // esp_timer time of fetch in microseconds
+  SHT3x_Sample_t Sample;
+} SHT3x_TaskMessage_t;
+
+
+/**
+ * @brief  Sensor task data type
+ * @note   All handlers must be initialized before starting the task. Handlers
+ *         in Single Shot mode are triggered together on each interval and
+ *         handlers in Periodic or ART mode are only fetched.
+ */
+typedef struct SHT3x_Task_s
+{
+  SHT3x_Handler_t *Handlers;
+  uint8_t Count;
+  uint32_t Interval;            // Sampling interval in milliseconds
+  QueueHandle_t Queue;          // Samples are published here
+  SemaphoreHandle_t BusMutex;   // Taken around each access to the bus
+
+  // Private data. Do not change it.
+  TaskHandle_t TaskHandle;
+  esp_timer_handle_t Timer;
+  uint32_t Dropped;
+  uint8_t OwnMutex;
+  volatile uint8_t Stop;
+} SHT3x_Task_t;
+
+
+
+/**
+ ==================================================================================
+                             ##### Task Functions #####                            
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize a sensor task over an array of handlers
+ * @note   Other code that accesses the same I2C bus (for example another
+ *         sensor task) must take Task->BusMutex while using the bus.
+ *
+ * @param  Task: Pointer to task
+ * @param  Handlers: Pointer to array of initialized handlers
+ * @param  Count: Number of handlers
+ * @param  Interval: Sampling interval in milliseconds
+ * @param  QueueLength: Number of messages the queue can hold
+ * @param  BusMutex: Mutex of the bus. If it is NULL a new mutex is created.
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to create the queue, mutex or timer.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_TaskInit(SHT3x_Task_t *Task, SHT3x_Handler_t *Handlers, uint8_t Count,
+               uint32_t Interval, uint8_t QueueLength,
+               SemaphoreHandle_t BusMutex);
+
+
+/**
+ * @brief  Free the resources of a stopped sensor task
+ * @param  Task: Pointer to task
+ * @retval None
+ */
+void
+SHT3x_TaskDeInit(SHT3x_Task_t *Task);
+
+
+/**
+ * @brief  Create the FreeRTOS task and start sampling
+ * @param  Task: Pointer to task
+ * @param  Name: Name of the FreeRTOS task
+ * @param  StackSize: Stack size of the FreeRTOS task
+ * @param  Priority: Priority of the FreeRTOS task
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to create the task or it is already running.
+ */
+SHT3x_Result_t
+SHT3x_TaskStart(SHT3x_Task_t *Task, const char *Name,
+                uint32_t StackSize, UBaseType_t Priority);
+
+
+/**
+ * @brief  Ask the sensor task to stop
+ * @note   The task finishes its current transfer and deletes itself.
+ *         SHT3x_TaskIsRunning() can be used to wait for it.
+ *
+ * @param  Task: Pointer to task
+ * @retval None
+ */
+void
+SHT3x_TaskStop(SHT3x_Task_t *Task);
+
+
+/**
+ * @brief  Check if the sensor task is running
+ * @param  Task: Pointer to task
+ * @retval 1 if the task is running, 0 otherwise
+ */
+uint8_t
+SHT3x_TaskIsRunning(SHT3x_Task_t *Task);
+
+
+/**
+ * @brief  Number of messages dropped because the queue was full
+ * @param  Task: Pointer to task
+ * @retval Number of dropped messages
+ */
+uint32_t
+SHT3x_TaskGetDropped(SHT3x_Task_t *Task);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _SHT3X_TASK_H_
@@ -0,0 +1,649 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_platform.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  SHT3x series driver platform dependent part (host simulation)
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "SHT3x_platform.h"
+#include <string.h>
+#if (SHT3X_CONFIG_STATIC_PLATFORM == 1)
+#include "SHT3x_static.h"
+#endif
+
+
+
+/* Private Macro ----------------------------------------------------------------*/
+/**
+ * @brief  Platform functions are called directly by the driver if
+ *         SHT3X_CONFIG_STATIC_PLATFORM is 1 (see SHT3x_static.h)
+ */
+#if (SHT3X_CONFIG_STATIC_PLATFORM == 1)
+#define SHT3X_PLATFORM_FUNCTION
+#else
+#define SHT3X_PLATFORM_FUNCTION  static
+#endif
+
+
+
+/* Private Constants ------------------------------------------------------------*/
+/**
+ * @brief  Simulated sensor states
+ */
+#define SIM_STATE_IDLE        0
+#define SIM_STATE_SINGLESHOT  1
+#define SIM_STATE_PERIODIC    2
+
+/**
+ * @brief  Status register bits
+ */
+#define SIM_STATUS_ALERT      0x8000
+#define SIM_STATUS_HEATER     0x2000
+#define SIM_STATUS_RH_ALERT   0x0800
+#define SIM_STATUS_T_ALERT    0x0400
+#define SIM_STATUS_RESET      0x0010
+#define SIM_STATUS_CMD_FAIL   0x0002
+#define SIM_STATUS_WRITE_CRC_FAIL 0x0001
+
+/**
+ * @brief  Typical measurement duration (us) for low, medium, high repeatability
+ */
+#define SIM_TIME_LOW      2500
+#define SIM_TIME_MEDIUM   4500
+#define SIM_TIME_HIGH     12500
+
+/**
+ * @brief  Soft reset time (us)
+ */
+#define SIM_TIME_RESET    1500
+
+/**
+ * @brief  Periodic mode commands
+ */
+static const struct
+{
+  uint8_t MSB;
+  uint8_t LSB;
+  uint32_t Period;   // us
+  uint32_t Duration; // us
+} Sim_PeriodicCommand[] =
+{
+  {0x20, 0x2F, 2000000, SIM_TIME_LOW}, {0x20, 0x24, 2000000, SIM_TIME_MEDIUM},
+  {0x20, 0x32, 2000000, SIM_TIME_HIGH},
+  {0x21, 0x2D, 1000000, SIM_TIME_LOW}, {0x21, 0x26, 1000000, SIM_TIME_MEDIUM},
+  {0x21, 0x30, 1000000, SIM_TIME_HIGH},
+  {0x22, 0x2B, 500000, SIM_TIME_LOW}, {0x22, 0x20, 500000, SIM_TIME_MEDIUM},
+  {0x22, 0x36, 500000, SIM_TIME_HIGH},
+  {0x23, 0x29, 250000, SIM_TIME_LOW}, {0x23, 0x22, 250000, SIM_TIME_MEDIUM},
+  {0x23, 0x34, 250000, SIM_TIME_HIGH},
+  {0x27, 0x2A, 100000, SIM_TIME_LOW}, {0x27, 0x21, 100000, SIM_TIME_MEDIUM},
+  {0x27, 0x37, 100000, SIM_TIME_HIGH},
+  {0x2B, 0x32, 250000, SIM_TIME_HIGH}, // ART
+};
+
+
+
+/**
+ * @brief  Alert limit commands [High set, high clear, low clear, low set][Read, Write]
+ */
+static const uint16_t Sim_AlertCommand[4][2] =
+{
+  {0xE11F, 0x611D}, {0xE114, 0x6116}, {0xE109, 0x610B}, {0xE102, 0x6100},
+};
+
+
+
+/* Private Variables ------------------------------------------------------------*/
+static SHT3x_PlatformSim_t DefaultSim;
+static uint8_t DefaultSimReady = 0;
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static SHT3x_PlatformSim_t *
+Platform_GetSim(void *Context)
+{
+  if (Context)
+    return (SHT3x_PlatformSim_t *)Context;
+
+  if (!DefaultSimReady)
+  {
+    SHT3x_PlatformSim_Init(&DefaultSim);
+    DefaultSimReady = 1;
+  }
+  return &DefaultSim;
+}
+
+
+static void
+Sim_BusTime(SHT3x_PlatformSim_t *Sim, uint8_t Len)
+{
+  // START + address + data (9 bits each) + STOP
+  Sim->Time += ((uint64_t)(Len + 1) * 9 + 2) * 1000000 / Sim->Rate;
+}
+
+
+/**
+ * @brief  A transfer on a stuck bus waits for the timeout and fails
+ */
+static uint8_t
+Sim_Stuck(SHT3x_PlatformSim_t *Sim)
+{
+  if (!Sim->BusStuck)
+    return 0;
+
+  Sim->Time += Sim->Timeout;
+  Sim->BusErrors++;
+  return 1;
+}
+
+
+static SHT3x_SimSensor_t *
+Sim_Select(SHT3x_PlatformSim_t *Sim, uint8_t Address)
+{
+  SHT3x_SimSensor_t *Sensor;
+
+  if (Address != 0x44 && Address != 0x45)
+    return NULL;
+
+  Sensor = &Sim->Sensor[Address - 0x44];
+  if (!Sensor->Present || Sim->Time < Sensor->BusyUntil)
+    return NULL;
+
+  return Sensor;
+}
+
+
+static void
+Sim_Update(SHT3x_PlatformSim_t *Sim, SHT3x_SimSensor_t *Sensor)
+{
+  if (Sensor->State != SIM_STATE_PERIODIC || Sim->Time < Sensor->NextSample)
+    return;
+
+  // Samples that are not fetched in time are overwritten
+  Sensor->DataReady = 1;
+  while (Sensor->NextSample <= Sim->Time)
+    Sensor->NextSample += Sensor->Period;
+}
+
+
+static void
+Sim_Word(uint8_t *Data, uint16_t Word)
+{
+  Data[0] = Word >> 8;
+  Data[1] = Word & 0xFF;
+  Data[2] = SHT3x_CalcCRC(Data, 2);
+}
+
+
+static void
+Sim_Sample(SHT3x_SimSensor_t *Sensor, uint8_t *Data)
+{
+  float Temperature = Sensor->Temperature;
+  float Humidity = Sensor->Humidity;
+
+  if (Temperature < -45.0f) Temperature = -45.0f;
+  if (Temperature > 130.0f) Temperature = 130.0f;
+  if (Humidity < 0.0f) Humidity = 0.0f;
+  if (Humidity > 100.0f) Humidity = 100.0f;
+
+  Sim_Word(&Data[0], (uint16_t)((Temperature + 45.0f) * 65535.0f / 175.0f + 0.5f));
+  Sim_Word(&Data[3], (uint16_t)(Humidity * 65535.0f / 100.0f + 0.5f));
+
+  Sensor->ReadCount++;
+  if (Sensor->CRCErrorEvery && (Sensor->ReadCount % Sensor->CRCErrorEvery) == 0)
+    Data[5] ^= 0xFF;
+}
+
+
+static void
+Sim_DefaultAlertLimits(SHT3x_SimSensor_t *Sensor)
+{
+  // Default limits of the sensor: 80%/60C, 79%/58C, 22%/-9C, 20%/-10C
+  Sensor->AlertLimit[0] = 0xCD33;
+  Sensor->AlertLimit[1] = 0xC92D;
+  Sensor->AlertLimit[2] = 0x3869;
+  Sensor->AlertLimit[3] = 0x3466;
+}
+
+
+static void
+Sim_Command(SHT3x_PlatformSim_t *Sim, SHT3x_SimSensor_t *Sensor,
+            uint8_t *Data, uint8_t DataLen)
+{
+  uint16_t Command;
+  uint8_t i;
+
+  if (DataLen < 2)
+  {
+    Sensor->Status |= SIM_STATUS_CMD_FAIL;
+    return;
+  }
+
+  Command = (Data[0] << 8) | Data[1];
+  Sensor->ResponseLen = 0;
+  Sensor->FetchRequested = 0;
+
+  for (i = 0; i < 4; i++)
+  {
+    if (Command == Sim_AlertCommand[i][0]) // Read alert limit
+    {
+      Sim_Word(Sensor->Response, Sensor->AlertLimit[i]);
+      Sensor->ResponseLen = 3;
+      return;
+    }
+
+    if (Command == Sim_AlertCommand[i][1]) // Write alert limit
+    {
+      if (DataLen != 5 || SHT3x_CalcCRC(&Data[2], 2) != Data[4])
+        Sensor->Status |= SIM_STATUS_WRITE_CRC_FAIL;
+      else
+        Sensor->AlertLimit[i] = (Data[2] << 8) | Data[3];
+      return;
+    }
+  }
+
+  if (Data[0] == 0x24 || Data[0] == 0x2C)
+  {
+    Sensor->State = SIM_STATE_SINGLESHOT;
+    Sensor->Stretching = (Data[0] == 0x2C);
+    if (Data[1] == 0x00 || Data[1] == 0x06)
+      Sensor->ReadyTime = Sim->Time + SIM_TIME_HIGH;
+    else if (Data[1] == 0x0B || Data[1] == 0x0D)
+      Sensor->ReadyTime = Sim->Time + SIM_TIME_MEDIUM;
+    else
+      Sensor->ReadyTime = Sim->Time + SIM_TIME_LOW;
+    return;
+  }
+
+  for (i = 0; i < sizeof(Sim_PeriodicCommand) / sizeof(Sim_PeriodicCommand[0]); i++)
+  {
+    if (Sim_PeriodicCommand[i].MSB == Data[0] &&
+        Sim_PeriodicCommand[i].LSB == Data[1])
+    {
+      Sensor->State = SIM_STATE_PERIODIC;
+      Sensor->Period = Sim_PeriodicCommand[i].Period;
+      Sensor->NextSample = Sim->Time + Sim_PeriodicCommand[i].Duration;
+      Sensor->DataReady = 0;
+      return;
+    }
+  }
+
+  switch (Command)
+  {
+  case 0xE000: // Fetch data
+    if (Sensor->State == SIM_STATE_PERIODIC)
+      Sensor->FetchRequested = 1;
+    else
+      Sensor->Status |= SIM_STATUS_CMD_FAIL;
+    break;
+
+  case 0x3093: // Break
+    Sensor->State = SIM_STATE_IDLE;
+    break;
+
+  case 0x30A2: // Soft reset
+    Sensor->State = SIM_STATE_IDLE;
+    Sim_DefaultAlertLimits(Sensor);
+    Sensor->DataReady = 0;
+    Sensor->Status = SIM_STATUS_ALERT | SIM_STATUS_RESET;
+    Sensor->BusyUntil = Sim->Time + SIM_TIME_RESET;
+    break;
+
+  case 0x306D: // Heater enable
+    Sensor->Status |= SIM_STATUS_HEATER;
+    break;
+
+  case 0x3066: // Heater disable
+    Sensor->Status &= ~SIM_STATUS_HEATER;
+    break;
+
+  case 0xF32D: // Read status
+    Sim_Word(Sensor->Response, Sensor->Status);
+    Sensor->ResponseLen = 3;
+    break;
+
+  case 0x3041: // Clear status
+    Sensor->Status &= ~(SIM_STATUS_ALERT | SIM_STATUS_RH_ALERT |
+                        SIM_STATUS_T_ALERT | SIM_STATUS_RESET);
+    break;
+
+  default:
+    Sensor->Status |= SIM_STATUS_CMD_FAIL;
+    break;
+  }
+}
+
+
+static int8_t
+Sim_Read(SHT3x_PlatformSim_t *Sim, SHT3x_SimSensor_t *Sensor,
+         uint8_t *Data, uint8_t DataLen)
+{
+  uint8_t Buffer[6] = {0};
+  uint8_t Len = 0;
+
+  Sim_Update(Sim, Sensor);
+
+  if (Sensor->ResponseLen)
+  {
+    memcpy(Buffer, Sensor->Response, Sensor->ResponseLen);
+    Len = Sensor->ResponseLen;
+    Sensor->ResponseLen = 0;
+  }
+  else if (Sensor->State == SIM_STATE_SINGLESHOT)
+  {
+    if (Sim->Time < Sensor->ReadyTime)
+    {
+      if (!Sensor->Stretching)
+        return -3;
+      Sim->Time = Sensor->ReadyTime; // SCL is held low until data is ready
+    }
+    Sim_Sample(Sensor, Buffer);
+    Len = 6;
+    Sensor->State = SIM_STATE_IDLE;
+  }
+  else if (Sensor->State == SIM_STATE_PERIODIC && Sensor->FetchRequested)
+  {
+    Sensor->FetchRequested = 0;
+    if (!Sensor->DataReady)
+      return -3;
+    Sim_Sample(Sensor, Buffer);
+    Len = 6;
+    Sensor->DataReady = 0;
+  }
+  else
+  {
+    return -3;
+  }
+
+  memset(Data, 0xFF, DataLen);
+  memcpy(Data, Buffer, (DataLen < Len) ? DataLen : Len);
+  Sim->BytesReceived += DataLen;
+
+  return 0;
+}
+
+
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_Init(void *Context)
+{
+  (void)Platform_GetSim(Context);
+  return 0;
+}
+
+
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_DeInit(void *Context)
+{
+  (void)Context;
+  return 0;
+}
+
+
+/**
+ * @brief  General call reset of all present sensors
+ */
+static int8_t
+Sim_GeneralCallReset(SHT3x_PlatformSim_t *Sim)
+{
+  uint8_t Reset[2] = {0x30, 0xA2};
+  uint8_t Acked = 0;
+
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    if (Sim->Sensor[i].Present && Sim->Time >= Sim->Sensor[i].BusyUntil)
+      Acked = 1;
+  }
+
+  if (!Acked)
+  {
+    Sim_BusTime(Sim, 0);
+    Sim->Nacks++;
+    return -3;
+  }
+
+  Sim_BusTime(Sim, 1);
+  Sim->BytesSent += 1;
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    if (Sim->Sensor[i].Present && Sim->Time >= Sim->Sensor[i].BusyUntil)
+      Sim_Command(Sim, &Sim->Sensor[i], Reset, 2);
+  }
+
+  return 0;
+}
+
+
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_WriteData(void *Context, uint8_t Address, uint8_t *Data, uint8_t DataLen)
+{
+  SHT3x_PlatformSim_t *Sim = Platform_GetSim(Context);
+  SHT3x_SimSensor_t *Sensor = Sim_Select(Sim, Address);
+
+  Sim->Transactions++;
+  if (Sim_Stuck(Sim))
+    return -1;
+  if (Address == 0x00 && DataLen == 1 && Data[0] == 0x06)
+    return Sim_GeneralCallReset(Sim);
+
+  if (!Sensor)
+  {
+    Sim_BusTime(Sim, 0);
+    Sim->Nacks++;
+    return -3;
+  }
+
+  Sim_BusTime(Sim, DataLen);
+  Sim->BytesSent += DataLen;
+  Sim_Command(Sim, Sensor, Data, DataLen);
+
+  return 0;
+}
+
+
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_ReadData(void *Context, uint8_t Address, uint8_t *Data, uint8_t DataLen)
+{
+  SHT3x_PlatformSim_t *Sim = Platform_GetSim(Context);
+  SHT3x_SimSensor_t *Sensor = Sim_Select(Sim, Address);
+
+  Sim->Transactions++;
+  if (Sim_Stuck(Sim))
+    return -1;
+  if (!Sensor || Sim_Read(Sim, Sensor, Data, DataLen) != 0)
+  {
+    Sim_BusTime(Sim, 0);
+    Sim->Nacks++;
+    return -3;
+  }
+
+  Sim_BusTime(Sim, DataLen);
+
+  return 0;
+}
+
+
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_WriteReadData(void *Context, uint8_t Address,
+                       uint8_t *TxData, uint8_t TxLen,
+                       uint8_t *RxData, uint8_t RxLen)
+{
+  SHT3x_PlatformSim_t *Sim = Platform_GetSim(Context);
+  SHT3x_SimSensor_t *Sensor = Sim_Select(Sim, Address);
+
+  Sim->Transactions++;
+  if (Sim_Stuck(Sim))
+    return -1;
+  if (!Sensor)
+  {
+    Sim_BusTime(Sim, 0);
+    Sim->Nacks++;
+    return -3;
+  }
+
+  // Repeated START costs one address byte but no STOP/START pair
+  Sim_BusTime(Sim, TxLen);
+  Sim->BytesSent += TxLen;
+  Sim_Command(Sim, Sensor, TxData, TxLen);
+
+  if (Sim_Read(Sim, Sensor, RxData, RxLen) != 0)
+  {
+    Sim->Time += 9 * 1000000 / Sim->Rate;
+    Sim->Nacks++;
+    return -3;
+  }
+  Sim->Time += (uint64_t)(RxLen + 1) * 9 * 1000000 / Sim->Rate;
+
+  return 0;
+}
+
+
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_Probe(void *Context, uint8_t Address)
+{
+  SHT3x_PlatformSim_t *Sim = Platform_GetSim(Context);
+
+  Sim->Transactions++;
+  if (Sim_Stuck(Sim))
+    return -1;
+  Sim_BusTime(Sim, 0);
+  if (!Sim_Select(Sim, Address))
+  {
+    Sim->Nacks++;
+    return -3;
+  }
+
+  return 0;
+}
+
+
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_BusRecovery(void *Context)
+{
+  SHT3x_PlatformSim_t *Sim = Platform_GetSim(Context);
+
+  // 9 clocks and a STOP condition
+  Sim->Time += 10 * 1000000 / Sim->Rate;
+  Sim->BusStuck = 0;
+  Sim->Recoveries++;
+
+  return 0;
+}
+
+
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_Delay(void *Context, uint8_t Delay)
+{
+  Platform_GetSim(Context)->Time += (uint64_t)Delay * 1000;
+  return 0;
+}
+
+
+SHT3X_PLATFORM_FUNCTION int8_t
+Platform_DelayUs(void *Context, uint32_t Delay)
+{
+  Platform_GetSim(Context)->Time += Delay;
+  return 0;
+}
+
+
+SHT3X_PLATFORM_FUNCTION uint32_t
+Platform_GetTime(void *Context)
+{
+  return (uint32_t)Platform_GetSim(Context)->Time;
+}
+
+
+
+/**
+ ==================================================================================
+                            ##### Public Functions #####                           
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize a simulated bus with default values
+ * @note   One sensor at address 0x44 is present at 25C and 50%.
+ * @param  Sim: Pointer to simulated bus
+ * @retval None
+ */
+void
+SHT3x_PlatformSim_Init(SHT3x_PlatformSim_t *Sim)
+{
+  memset(Sim, 0, sizeof(*Sim));
+  Sim->Rate = SHT3X_SIM_I2C_RATE;
+  Sim->Timeout = SHT3X_SIM_TIMEOUT;
+  Sim->Sensor[0].Present = 1;
+  Sim->Sensor[0].Temperature = 25.0f;
+  Sim->Sensor[0].Humidity = 50.0f;
+  Sim->Sensor[0].Status = SIM_STATUS_ALERT | SIM_STATUS_RESET;
+  Sim_DefaultAlertLimits(&Sim->Sensor[0]);
+  Sim->Sensor[1].Temperature = 25.0f;
+  Sim->Sensor[1].Humidity = 50.0f;
+  Sim->Sensor[1].Status = SIM_STATUS_ALERT | SIM_STATUS_RESET;
+  Sim_DefaultAlertLimits(&Sim->Sensor[1]);
+}
+
+
+/**
+ * @brief  Get the simulated bus of a handler
+ * @param  Handler: Pointer to handler
+ * @retval Pointer to simulated bus
+ */
+SHT3x_PlatformSim_t *
+SHT3x_PlatformSim_Get(SHT3x_Handler_t *Handler)
+{
+  return Platform_GetSim(Handler->Context);
+}
+
+
+/**
+ * @brief  Initialize platform device to communicate SHT3x.
+ * @param  Handler: Pointer to handler
+ * @retval None
+ */
+void
+SHT3x_Platform_Init(SHT3x_Handler_t *Handler)
+{
+  Handler->PlatformInit = Platform_Init;
+  Handler->PlatformDeInit = Platform_DeInit;
+  Handler->PlatformSend = Platform_WriteData;
+  Handler->PlatformReceive = Platform_ReadData;
+  Handler->PlatformSendReceive = Platform_WriteReadData;
+  Handler->PlatformCRC = NULL; // Use built-in CRC check
+  Handler->PlatformProbe = Platform_Probe;
+  Handler->PlatformBusRecovery = Platform_BusRecovery;
+  Handler->PlatformDelay = Platform_Delay;
+  Handler->PlatformDelayUs = Platform_DelayUs;
+  Handler->PlatformGetTime = Platform_GetTime;
+}
@@ -0,0 +1,154 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_platform.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  SHT3x series driver platform dependent part (host simulation)
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef	_SHT3X_PLATFORM_H_
+#define _SHT3X_PLATFORM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "SHT3x.h"
+
+
+/* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Default I2C bus rate of the simulated bus
+ */
+#define SHT3X_SIM_I2C_RATE  100000
+
+/**
+ * @brief  Default transfer timeout of the simulated bus in us
+ */
+#define SHT3X_SIM_TIMEOUT   100000
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Simulated sensor data type
+ */
+typedef struct SHT3x_SimSensor_s
+{
+  uint8_t Present;
+  float Temperature;        // Simulated temperature in C
+  float Humidity;           // Simulated relative humidity in %
+  uint16_t CRCErrorEvery;   // Corrupt the CRC of every Nth data read (0: never)
+
+  // Private data. Do not change it.
+  uint8_t State;
+  uint8_t Stretching;
+  uint8_t FetchRequested;
+  uint8_t DataReady;
+  uint16_t Status;
+  uint16_t ReadCount;
+  uint32_t Period;
+  uint64_t ReadyTime;
+  uint64_t NextSample;
+  uint64_t BusyUntil;
+  uint16_t AlertLimit[4];   // High set, high clear, low clear, low set
+  uint8_t Response[3];
+  uint8_t ResponseLen;
+} SHT3x_SimSensor_t;
+
+
+/**
+ * @brief  Simulated I2C bus data type
+ * @note   Set Handler->Context to a pointer of this type. If it is NULL, a
+ *         default bus with one sensor at address 0x44 is used.
+ * @note   Time is a virtual clock in us. Transfers advance it by the bus time
+ *         and PlatformDelay advances it without sleeping.
+ */
+typedef struct SHT3x_PlatformSim_s
+{
+  uint32_t Rate;
+  SHT3x_SimSensor_t Sensor[2];  // Sensors at address 0x44 and 0x45
+  uint64_t Time;
+  uint8_t BusStuck;     // 1: SDA is held low, transfers fail after Timeout
+                        // until the bus is recovered
+  uint32_t Timeout;     // Transfer timeout in us
+
+  // Bus statistics
+  uint32_t Transactions;
+  uint32_t BytesSent;
+  uint32_t BytesReceived;
+  uint32_t Nacks;
+  uint32_t BusErrors;
+  uint32_t Recoveries;
+} SHT3x_PlatformSim_t;
+
+
+
+/**
+ ==================================================================================
+                             ##### Functions #####                                 
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize a simulated bus with default values
+ * @note   One sensor at address 0x44 is present at 25C and 50%.
+ * @param  Sim: Pointer to simulated bus
+ * @retval None
+ */
+void
+SHT3x_PlatformSim_Init(SHT3x_PlatformSim_t *Sim);
+
+
+/**
+ * @brief  Get the simulated bus of a handler
+ * @param  Handler: Pointer to handler
+ * @retval Pointer to simulated bus
+ */
+SHT3x_PlatformSim_t *
+SHT3x_PlatformSim_Get(SHT3x_Handler_t *Handler);
+
+
+/**
+ * @brief  Initialize platform device to communicate SHT3x.
+ * @note   Handler->Context is not changed.
+ * @param  Handler: Pointer to handler
+ * @retval None
+ */
+void
+SHT3x_Platform_Init(SHT3x_Handler_t *Handler);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif //! _SHT3X_PLATFORM_H_
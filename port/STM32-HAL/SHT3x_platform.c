@@ -30,11 +30,27 @@
 
 /* Includes ---------------------------------------------------------------------*/
 #include "SHT3x_platform.h"
-#include "main.h"
 
 
 /* Private Constants ------------------------------------------------------------*/
-#define SHT3X_TIMEOUT 100
+#define SHT3X_PROBE_TIMEOUT 2
+
+
+
+/* Private Data Types -----------------------------------------------------------*/
+typedef struct Platform_AsyncTransfer_s
+{
+  I2C_HandleTypeDef *hi2c;
+  SHT3x_TransferDone_t Done;
+  void *Arg;
+} Platform_AsyncTransfer_t;
+
+
+
+/* Private Variables ------------------------------------------------------------*/
+extern I2C_HandleTypeDef SHT3X_HI2C;
+
+static Platform_AsyncTransfer_t AsyncTransfers[SHT3X_ASYNC_MAX_BUSES];
 
 
 
@@ -44,61 +60,251 @@
  ==================================================================================
  */
 
+static I2C_HandleTypeDef *
+Platform_GetI2C(void *Context)
+{
+  if (Context)
+    return ((SHT3x_PlatformBus_t *)Context)->hi2c;
+
+  return &SHT3X_HI2C;
+}
+
+
+static uint32_t
+Platform_GetTimeout(void *Context)
+{
+  if (Context && ((SHT3x_PlatformBus_t *)Context)->Timeout)
+    return ((SHT3x_PlatformBus_t *)Context)->Timeout;
+
+  return SHT3X_TIMEOUT;
+}
+
+
 static int8_t
-Platform_Init(void)
+Platform_Init(void *Context)
 {
+  (void)Context;
   return 0;
 }
 
 
 static int8_t
-Platform_DeInit(void)
+Platform_DeInit(void *Context)
 {
+  (void)Context;
   return 0;
 }
 
 
 static int8_t
-Platform_WriteData(uint8_t Address, uint8_t *Data, uint8_t DataLen)
+Platform_Error(void *Context)
 {
-  extern I2C_HandleTypeDef SHT3X_HI2C;
+  // Acknowledge failure: the slave doesn't ACK
+  if (HAL_I2C_GetError(Platform_GetI2C(Context)) & HAL_I2C_ERROR_AF)
+    return -3;
+
+  return -1;
+}
 
+
+static int8_t
+Platform_WriteData(void *Context, uint8_t Address, uint8_t *Data, uint8_t DataLen)
+{
   Address <<= 1;
-  if (HAL_I2C_Master_Transmit(&SHT3X_HI2C, Address, Data, DataLen, SHT3X_TIMEOUT))
-    return -1;
+  if (HAL_I2C_Master_Transmit(Platform_GetI2C(Context), Address, Data, DataLen,
+                              Platform_GetTimeout(Context)))
+    return Platform_Error(Context);
+
+  return 0;
+}
+
+
+static int8_t
+Platform_ReadData(void *Context, uint8_t Address, uint8_t *Data, uint8_t DataLen)
+{
+  Address <<= 1;
+  if (HAL_I2C_Master_Receive(Platform_GetI2C(Context), Address, Data, DataLen,
+                             Platform_GetTimeout(Context)))
+    return Platform_Error(Context);
 
   return 0;
 }
 
+static Platform_AsyncTransfer_t *
+Platform_FindAsyncTransfer(I2C_HandleTypeDef *hi2c)
+{
+  for (uint8_t i = 0; i < SHT3X_ASYNC_MAX_BUSES; i++)
+  {
+    if (AsyncTransfers[i].hi2c == hi2c)
+      return &AsyncTransfers[i];
+  }
+
+  return NULL;
+}
 
 static int8_t
-Platform_ReadData(uint8_t Address, uint8_t *Data, uint8_t DataLen)
+Platform_TransferAsync(void *Context, uint8_t Address, uint8_t *Data,
+                       uint8_t DataLen, uint8_t Read,
+                       SHT3x_TransferDone_t Done, void *Arg)
 {
-  extern I2C_HandleTypeDef SHT3X_HI2C;
+  I2C_HandleTypeDef *hi2c = Platform_GetI2C(Context);
+  Platform_AsyncTransfer_t *Transfer = Platform_FindAsyncTransfer(hi2c);
+  HAL_StatusTypeDef Status = HAL_OK;
+
+  if (!Transfer)
+  {
+    Transfer = Platform_FindAsyncTransfer(NULL);
+    if (!Transfer)
+      return -1;
+    Transfer->hi2c = hi2c;
+  }
+
+  if (Transfer->Done)
+    return -2;
+
+  Transfer->Done = Done;
+  Transfer->Arg = Arg;
 
   Address <<= 1;
-  if (HAL_I2C_Master_Receive(&SHT3X_HI2C, Address, Data, DataLen, SHT3X_TIMEOUT))
-    return -1;
+#if (SHT3X_ASYNC_DMA == 1)
+  if (Read)
+    Status = HAL_I2C_Master_Receive_DMA(hi2c, Address, Data, DataLen);
+  else
+    Status = HAL_I2C_Master_Transmit_DMA(hi2c, Address, Data, DataLen);
+#else
+  if (Read)
+    Status = HAL_I2C_Master_Receive_IT(hi2c, Address, Data, DataLen);
+  else
+    Status = HAL_I2C_Master_Transmit_IT(hi2c, Address, Data, DataLen);
+#endif
+
+  if (Status != HAL_OK)
+  {
+    Transfer->Done = NULL;
+    return (Status == HAL_BUSY) ? -2 : -1;
+  }
 
   return 0;
 }
 
+static void
+Platform_FinishAsyncTransfer(I2C_HandleTypeDef *hi2c, int8_t Result)
+{
+  Platform_AsyncTransfer_t *Transfer = Platform_FindAsyncTransfer(hi2c);
+  SHT3x_TransferDone_t Done = NULL;
+
+  if (!Transfer || !Transfer->Done)
+    return;
+
+  Done = Transfer->Done;
+  Transfer->Done = NULL;
+  Done(Transfer->Arg, Result);
+}
+
+static int8_t
+Platform_WriteReadData(void *Context, uint8_t Address,
+                       uint8_t *TxData, uint8_t TxLen,
+                       uint8_t *RxData, uint8_t RxLen)
+{
+  HAL_StatusTypeDef Status;
+
+  if (TxLen != 2)
+    return -1;
+
+  // The 16 bit command is sent as memory address, followed by repeated START
+  Address <<= 1;
+  Status = HAL_I2C_Mem_Read(Platform_GetI2C(Context), Address,
+                            (TxData[0] << 8) | TxData[1], I2C_MEMADD_SIZE_16BIT,
+                            RxData, RxLen, Platform_GetTimeout(Context));
+  if (Status == HAL_OK)
+    return 0;
+
+  return Platform_Error(Context);
+}
+
+static int8_t
+Platform_Probe(void *Context, uint8_t Address)
+{
+  HAL_StatusTypeDef Status;
+
+  Address <<= 1;
+  Status = HAL_I2C_IsDeviceReady(Platform_GetI2C(Context), Address, 1,
+                                 SHT3X_PROBE_TIMEOUT);
+  if (Status == HAL_OK)
+    return 0;
+  if (Status == HAL_BUSY)
+    return -1;
+
+  return -3;
+}
+
+static void
+Platform_RecoveryDelay(void)
+{
+  // About 5 us (less than 100 kHz), no timer is needed
+  for (volatile uint16_t i = 0; i < 200; i++) {}
+}
+
 static int8_t
-Platform_CRC(uint16_t Data, uint8_t DataCRC)
+Platform_BusRecovery(void *Context)
 {
-  (void)Data;
-  (void)DataCRC;
+  SHT3x_PlatformBus_t *Bus = (SHT3x_PlatformBus_t *)Context;
+  I2C_HandleTypeDef *hi2c = Platform_GetI2C(Context);
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  HAL_I2C_DeInit(hi2c);
+
+  if (Bus && Bus->SCLPort && Bus->SDAPort)
+  {
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    GPIO_InitStruct.Pin = Bus->SCLPin;
+    HAL_GPIO_WritePin(Bus->SCLPort, Bus->SCLPin, GPIO_PIN_SET);
+    HAL_GPIO_Init(Bus->SCLPort, &GPIO_InitStruct);
+    GPIO_InitStruct.Pin = Bus->SDAPin;
+    HAL_GPIO_WritePin(Bus->SDAPort, Bus->SDAPin, GPIO_PIN_SET);
+    HAL_GPIO_Init(Bus->SDAPort, &GPIO_InitStruct);
+
+    // 9 clocks release a slave that holds SDA low
+    for (uint8_t i = 0; i < 9; i++)
+    {
+      HAL_GPIO_WritePin(Bus->SCLPort, Bus->SCLPin, GPIO_PIN_RESET);
+      Platform_RecoveryDelay();
+      HAL_GPIO_WritePin(Bus->SCLPort, Bus->SCLPin, GPIO_PIN_SET);
+      Platform_RecoveryDelay();
+    }
+
+    // STOP condition: SDA goes high while SCL is high
+    HAL_GPIO_WritePin(Bus->SDAPort, Bus->SDAPin, GPIO_PIN_RESET);
+    Platform_RecoveryDelay();
+    HAL_GPIO_WritePin(Bus->SDAPort, Bus->SDAPin, GPIO_PIN_SET);
+    Platform_RecoveryDelay();
+  }
+
+  // HAL_I2C_MspInit() configures the pins for I2C again
+  if (HAL_I2C_Init(hi2c) != HAL_OK)
+    return -1;
+
   return 0;
 }
 
 static int8_t
-Platform_Delay(uint8_t Delay)
+Platform_Delay(void *Context, uint8_t Delay)
 {
+  (void)Context;
   HAL_Delay(Delay);
 
   return 0;
 }
 
+static uint32_t
+Platform_GetTime(void *Context)
+{
+  (void)Context;
+  return HAL_GetTick() * 1000;
+}
+
 
 /**
  ==================================================================================
@@ -118,6 +324,62 @@ SHT3x_Platform_Init(SHT3x_Handler_t *Handler)
   Handler->PlatformDeInit = Platform_DeInit;
   Handler->PlatformSend = Platform_WriteData;
   Handler->PlatformReceive = Platform_ReadData;
-  Handler->PlatformCRC = Platform_CRC;
+  Handler->PlatformSendReceive = Platform_WriteReadData;
+  Handler->PlatformCRC = NULL; // Use built-in CRC check
+  Handler->PlatformProbe = Platform_Probe;
+  Handler->PlatformBusRecovery = Platform_BusRecovery;
   Handler->PlatformDelay = Platform_Delay;
+  Handler->PlatformGetTime = Platform_GetTime;
+  Handler->PlatformTransferAsync = Platform_TransferAsync;
+}
+
+
+/**
+ * @brief  Completion handler of asynchronous transfers.
+ * @note   Call it from HAL_I2C_MasterTxCpltCallback and
+ *         HAL_I2C_MasterRxCpltCallback if SHT3X_ASYNC_HAL_CALLBACKS is 0.
+ * @param  hi2c: Pointer to I2C handle
+ * @retval None
+ */
+void
+SHT3x_Platform_I2C_CpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  Platform_FinishAsyncTransfer(hi2c, 0);
+}
+
+
+/**
+ * @brief  Error handler of asynchronous transfers.
+ * @note   Call it from HAL_I2C_ErrorCallback if SHT3X_ASYNC_HAL_CALLBACKS is 0.
+ * @param  hi2c: Pointer to I2C handle
+ * @retval None
+ */
+void
+SHT3x_Platform_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+  if (HAL_I2C_GetError(hi2c) & HAL_I2C_ERROR_AF)
+    Platform_FinishAsyncTransfer(hi2c, -3);
+  else
+    Platform_FinishAsyncTransfer(hi2c, -1);
+}
+
+
+#if (SHT3X_ASYNC_HAL_CALLBACKS == 1)
+void
+HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  SHT3x_Platform_I2C_CpltCallback(hi2c);
+}
+
+void
+HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  SHT3x_Platform_I2C_CpltCallback(hi2c);
+}
+
+void
+HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+  SHT3x_Platform_I2C_ErrorCallback(hi2c);
 }
+#endif
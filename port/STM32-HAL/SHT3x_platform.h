@@ -39,11 +39,57 @@ extern "C" {
 
 /* Includes ---------------------------------------------------------------------*/
 #include "SHT3x.h"
+#include "main.h"
 
 
 /* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Default I2C handle (used when Handler->Context is NULL)
+ */
 #define SHT3X_HI2C      hi2c2
 
+/**
+ * @brief  Default timeout of each I2C transfer in ms (used when Timeout of
+ *         the bus is 0)
+ */
+#define SHT3X_TIMEOUT   100
+
+/**
+ * @brief  Asynchronous transfer options
+ *         - SHT3X_ASYNC_DMA: 0 to use interrupt transfers (HAL_I2C_xxx_IT),
+ *           1 to use DMA transfers (HAL_I2C_xxx_DMA)
+ *         - SHT3X_ASYNC_HAL_CALLBACKS: 1 to define HAL_I2C_MasterTxCpltCallback,
+ *           HAL_I2C_MasterRxCpltCallback and HAL_I2C_ErrorCallback in this
+ *           file. Set it to 0 if your application defines them and call
+ *           SHT3x_Platform_I2C_CpltCallback() and
+ *           SHT3x_Platform_I2C_ErrorCallback() from them.
+ *         - SHT3X_ASYNC_MAX_BUSES: Maximum number of I2C handles that are used
+ *           for asynchronous transfers
+ */
+#define SHT3X_ASYNC_DMA             0
+#define SHT3X_ASYNC_HAL_CALLBACKS   1
+#define SHT3X_ASYNC_MAX_BUSES       2
+
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  I2C bus data type
+ * @note   Set Handler->Context to a pointer of this type to use another bus.
+ */
+typedef struct SHT3x_PlatformBus_s
+{
+  I2C_HandleTypeDef *hi2c;
+  uint32_t Timeout;         // Transfer timeout in ms (0: SHT3X_TIMEOUT)
+
+  // Pins for bus recovery (optional). If SCLPort is NULL, bus recovery only
+  // reinitializes the I2C peripheral.
+  GPIO_TypeDef *SCLPort;
+  uint16_t SCLPin;
+  GPIO_TypeDef *SDAPort;
+  uint16_t SDAPin;
+} SHT3x_PlatformBus_t;
+
 
 
 /**
@@ -54,6 +100,8 @@ extern "C" {
 
 /**
  * @brief  Initialize platform device to communicate SHT3x.
+ * @note   Handler->Context is not changed. If it is NULL, the default I2C
+ *         handle is used.
  * @param  Handler: Pointer to handler
  * @retval None
  */
@@ -61,6 +109,27 @@ void
 SHT3x_Platform_Init(SHT3x_Handler_t *Handler);
 
 
+/**
+ * @brief  Completion handler of asynchronous transfers.
+ * @note   Call it from HAL_I2C_MasterTxCpltCallback and
+ *         HAL_I2C_MasterRxCpltCallback if SHT3X_ASYNC_HAL_CALLBACKS is 0.
+ * @param  hi2c: Pointer to I2C handle
+ * @retval None
+ */
+void
+SHT3x_Platform_I2C_CpltCallback(I2C_HandleTypeDef *hi2c);
+
+
+/**
+ * @brief  Error handler of asynchronous transfers.
+ * @note   Call it from HAL_I2C_ErrorCallback if SHT3X_ASYNC_HAL_CALLBACKS is 0.
+ * @param  hi2c: Pointer to I2C handle
+ * @retval None
+ */
+void
+SHT3x_Platform_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+
 #ifdef __cplusplus
 }
 #endif
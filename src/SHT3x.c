@@ -34,6 +34,186 @@
 
 /* Includes ---------------------------------------------------------------------*/
 #include "SHT3x.h"
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#endif
+
+
+
+/* Private Macro ----------------------------------------------------------------*/
+/**
+ * @brief  Constant data placement (keep lookup tables in flash on AVR)
+ */
+#if defined(__AVR__)
+#define SHT3X_CONST_DATA          PROGMEM
+#define SHT3X_READ_CONST_BYTE(x)  pgm_read_byte(&(x))
+#else
+#define SHT3X_CONST_DATA
+#define SHT3X_READ_CONST_BYTE(x)  (x)
+#endif
+
+
+
+/**
+ * @brief  Platform function calls. They are direct calls of the functions of
+ *         SHT3X_CONFIG_STATIC_PLATFORM_HEADER if SHT3X_CONFIG_STATIC_PLATFORM
+ *         is 1.
+ */
+#if (SHT3X_CONFIG_STATIC_PLATFORM == 1)
+#include SHT3X_CONFIG_STATIC_PLATFORM_HEADER
+
+#define SHT3X_CALL_SEND(Handler, ...) \
+  SHT3X_STATIC_SEND((Handler)->Context, __VA_ARGS__)
+#define SHT3X_CALL_RECEIVE(Handler, ...) \
+  SHT3X_STATIC_RECEIVE((Handler)->Context, __VA_ARGS__)
+#define SHT3X_CALL_DELAY(Handler, ...) \
+  SHT3X_STATIC_DELAY((Handler)->Context, __VA_ARGS__)
+
+#ifdef SHT3X_STATIC_INIT
+#define SHT3X_HAS_INIT(Handler)   1
+#define SHT3X_CALL_INIT(Handler)  SHT3X_STATIC_INIT((Handler)->Context)
+#else
+#define SHT3X_STATIC_INIT         NULL
+#define SHT3X_HAS_INIT(Handler)   0
+#define SHT3X_CALL_INIT(Handler)  ((void)(Handler), (int8_t)0)
+#endif
+
+#ifdef SHT3X_STATIC_DEINIT
+#define SHT3X_HAS_DEINIT(Handler)   1
+#define SHT3X_CALL_DEINIT(Handler)  SHT3X_STATIC_DEINIT((Handler)->Context)
+#else
+#define SHT3X_STATIC_DEINIT         NULL
+#define SHT3X_HAS_DEINIT(Handler)   0
+#define SHT3X_CALL_DEINIT(Handler)  ((void)(Handler), (int8_t)0)
+#endif
+
+#ifdef SHT3X_STATIC_DELAY_US
+#define SHT3X_HAS_DELAY_US(Handler)  1
+#define SHT3X_CALL_DELAY_US(Handler, ...) \
+  SHT3X_STATIC_DELAY_US((Handler)->Context, __VA_ARGS__)
+#else
+#define SHT3X_STATIC_DELAY_US        NULL
+#define SHT3X_HAS_DELAY_US(Handler)  0
+#define SHT3X_CALL_DELAY_US(Handler, ...)  ((void)(Handler))
+#endif
+
+#ifdef SHT3X_STATIC_GET_TIME
+#define SHT3X_HAS_GET_TIME(Handler)   1
+#define SHT3X_CALL_GET_TIME(Handler)  SHT3X_STATIC_GET_TIME((Handler)->Context)
+#else
+#define SHT3X_STATIC_GET_TIME         NULL
+#define SHT3X_HAS_GET_TIME(Handler)   0
+#define SHT3X_CALL_GET_TIME(Handler)  ((void)(Handler), (uint32_t)0)
+#endif
+
+#ifdef SHT3X_STATIC_SEND_RECEIVE
+#define SHT3X_HAS_SEND_RECEIVE(Handler)  1
+#define SHT3X_CALL_SEND_RECEIVE(Handler, ...) \
+  SHT3X_STATIC_SEND_RECEIVE((Handler)->Context, __VA_ARGS__)
+#else
+#define SHT3X_STATIC_SEND_RECEIVE        NULL
+#define SHT3X_HAS_SEND_RECEIVE(Handler)  0
+#define SHT3X_CALL_SEND_RECEIVE(Handler, ...)  ((void)(Handler), (int8_t)-1)
+#endif
+
+#ifdef SHT3X_STATIC_PROBE
+#define SHT3X_HAS_PROBE(Handler)  1
+#define SHT3X_CALL_PROBE(Handler, ...) \
+  SHT3X_STATIC_PROBE((Handler)->Context, __VA_ARGS__)
+#else
+#define SHT3X_STATIC_PROBE        NULL
+#define SHT3X_HAS_PROBE(Handler)  0
+#define SHT3X_CALL_PROBE(Handler, ...)  ((void)(Handler), (int8_t)0)
+#endif
+
+#ifdef SHT3X_STATIC_BUS_RECOVERY
+#define SHT3X_HAS_BUS_RECOVERY(Handler)   1
+#define SHT3X_CALL_BUS_RECOVERY(Handler)  SHT3X_STATIC_BUS_RECOVERY((Handler)->Context)
+#else
+#define SHT3X_STATIC_BUS_RECOVERY         NULL
+#define SHT3X_HAS_BUS_RECOVERY(Handler)   0
+#define SHT3X_CALL_BUS_RECOVERY(Handler)  ((void)(Handler), (int8_t)-1)
+#endif
+
+#ifdef SHT3X_STATIC_LOCK
+#define SHT3X_HAS_LOCK(Handler)     1
+#define SHT3X_CALL_LOCK(Handler)    SHT3X_STATIC_LOCK((Handler)->Context)
+#define SHT3X_CALL_UNLOCK(Handler)  SHT3X_STATIC_UNLOCK((Handler)->Context)
+#else
+#define SHT3X_STATIC_LOCK           NULL
+#define SHT3X_STATIC_UNLOCK         NULL
+#define SHT3X_HAS_LOCK(Handler)     0
+#define SHT3X_CALL_LOCK(Handler)    ((void)(Handler), (int8_t)0)
+#define SHT3X_CALL_UNLOCK(Handler)  ((void)(Handler), (int8_t)0)
+#endif
+
+#else
+#define SHT3X_CALL_SEND(Handler, ...) \
+  (Handler)->PlatformSend((Handler)->Context, __VA_ARGS__)
+#define SHT3X_CALL_RECEIVE(Handler, ...) \
+  (Handler)->PlatformReceive((Handler)->Context, __VA_ARGS__)
+#define SHT3X_CALL_DELAY(Handler, ...) \
+  (Handler)->PlatformDelay((Handler)->Context, __VA_ARGS__)
+#define SHT3X_HAS_INIT(Handler)       ((Handler)->PlatformInit != NULL)
+#define SHT3X_CALL_INIT(Handler)      (Handler)->PlatformInit((Handler)->Context)
+#define SHT3X_HAS_DEINIT(Handler)     ((Handler)->PlatformDeInit != NULL)
+#define SHT3X_CALL_DEINIT(Handler)    (Handler)->PlatformDeInit((Handler)->Context)
+#define SHT3X_HAS_DELAY_US(Handler)   ((Handler)->PlatformDelayUs != NULL)
+#define SHT3X_CALL_DELAY_US(Handler, ...) \
+  (Handler)->PlatformDelayUs((Handler)->Context, __VA_ARGS__)
+#define SHT3X_HAS_GET_TIME(Handler)   ((Handler)->PlatformGetTime != NULL)
+#define SHT3X_CALL_GET_TIME(Handler)  (Handler)->PlatformGetTime((Handler)->Context)
+#define SHT3X_HAS_SEND_RECEIVE(Handler)  ((Handler)->PlatformSendReceive != NULL)
+#define SHT3X_CALL_SEND_RECEIVE(Handler, ...) \
+  (Handler)->PlatformSendReceive((Handler)->Context, __VA_ARGS__)
+#define SHT3X_HAS_PROBE(Handler)      ((Handler)->PlatformProbe != NULL)
+#define SHT3X_CALL_PROBE(Handler, ...) \
+  (Handler)->PlatformProbe((Handler)->Context, __VA_ARGS__)
+#define SHT3X_HAS_BUS_RECOVERY(Handler)   ((Handler)->PlatformBusRecovery != NULL)
+#define SHT3X_CALL_BUS_RECOVERY(Handler)  (Handler)->PlatformBusRecovery((Handler)->Context)
+#define SHT3X_HAS_LOCK(Handler)       ((Handler)->PlatformLock != NULL)
+#define SHT3X_CALL_LOCK(Handler)      (Handler)->PlatformLock((Handler)->Context)
+#define SHT3X_CALL_UNLOCK(Handler) \
+  ((Handler)->PlatformUnlock ? (Handler)->PlatformUnlock((Handler)->Context) : 0)
+#endif
+
+
+
+/**
+ * @brief  Measurement mode and repeatability (constants if they are fixed by
+ *         SHT3X_CONFIG_STATIC_MODE and SHT3X_CONFIG_STATIC_REPEATABILITY)
+ */
+#if (SHT3X_CONFIG_STATIC_MODE >= 0)
+#define SHT3X_MODE(Handler)  ((void)(Handler), (SHT3x_Mode_t)SHT3X_CONFIG_STATIC_MODE)
+#define SHT3X_MODE_ALLOWED(Mode)  ((Mode) == SHT3X_CONFIG_STATIC_MODE)
+#else
+#define SHT3X_MODE(Handler)  ((Handler)->Mode)
+#define SHT3X_MODE_ALLOWED(Mode)  1
+#endif
+
+#if (SHT3X_CONFIG_STATIC_REPEATABILITY >= 0)
+#define SHT3X_REPEATABILITY(Handler) \
+  ((void)(Handler), (SHT3x_Repeatability_t)SHT3X_CONFIG_STATIC_REPEATABILITY)
+#define SHT3X_REPEATABILITY_ALLOWED(Repeatability) \
+  ((Repeatability) == SHT3X_CONFIG_STATIC_REPEATABILITY)
+#define SHT3X_DEFAULT_REPEATABILITY \
+  ((SHT3x_Repeatability_t)SHT3X_CONFIG_STATIC_REPEATABILITY)
+#else
+#define SHT3X_REPEATABILITY(Handler)  ((Handler)->Repeatability)
+#define SHT3X_REPEATABILITY_ALLOWED(Repeatability)  1
+#define SHT3X_DEFAULT_REPEATABILITY   SHT3x_REPEATABILITY_LOW
+#endif
+
+
+
+/**
+ * @brief  Update a performance counter
+ */
+#if (SHT3X_CONFIG_STATS == 1)
+#define SHT3X_STATS_INC(Handler, Counter)  ((Handler)->Stats.Counter++)
+#else
+#define SHT3X_STATS_INC(Handler, Counter)  ((void)0)
+#endif
 
 
 
@@ -43,6 +223,7 @@
  */
 #define SHT3X_I2C_ADDRESS_A   0x44
 #define SHT3X_I2C_ADDRESS_B   0x45
+#define SHT3X_I2C_ADDRESS_GENERAL_CALL  0x00
 
 
 /**
@@ -105,6 +286,11 @@
 #define SHT3X_COMMAND_SOFT_RESET_MSB  0x30
 #define SHT3X_COMMAND_SOFT_RESET_LSB  0xA2
 
+/**
+ * @brief  General call reset (second byte after the general call address)
+ */
+#define SHT3X_COMMAND_GENERAL_CALL_RESET  0x06
+
 /**
  * @brief  Heater commands
  */
@@ -121,349 +307,1629 @@
 #define SHT3X_COMMAND_STATUS_CLEAR_MSB    0x30
 #define SHT3X_COMMAND_STATUS_CLEAR_LSB    0x41
 
+/**
+ * @brief  Alert limit commands
+ */
+#define SHT3X_COMMAND_ALERT_READ_MSB              0xE1
+#define SHT3X_COMMAND_ALERT_READ_HIGH_SET_LSB     0x1F
+#define SHT3X_COMMAND_ALERT_READ_HIGH_CLEAR_LSB   0x14
+#define SHT3X_COMMAND_ALERT_READ_LOW_CLEAR_LSB    0x09
+#define SHT3X_COMMAND_ALERT_READ_LOW_SET_LSB      0x02
+#define SHT3X_COMMAND_ALERT_WRITE_MSB             0x61
+#define SHT3X_COMMAND_ALERT_WRITE_HIGH_SET_LSB    0x1D
+#define SHT3X_COMMAND_ALERT_WRITE_HIGH_CLEAR_LSB  0x16
+#define SHT3X_COMMAND_ALERT_WRITE_LOW_CLEAR_LSB   0x0B
+#define SHT3X_COMMAND_ALERT_WRITE_LOW_SET_LSB     0x00
 
+/**
+ * @brief  Maximum measurement duration in single shot mode (in us)
+ */
+#define SHT3X_MEASUREMENT_TIME_LOW      4000
+#define SHT3X_MEASUREMENT_TIME_MEDIUM   6000
+#define SHT3X_MEASUREMENT_TIME_HIGH     15000
 
 /**
- ==================================================================================
-                       ##### Private Functions #####                               
- ==================================================================================
+ * @brief  Maximum soft reset duration (in us)
  */
+#define SHT3X_SOFT_RESET_TIME   1500
 
-static void
-SHT3x_ConvSample(SHT3x_Sample_t *Sample)
-{
-  float TempBuff = 0;
+/**
+ * @brief  Polling of sample (in us)
+ */
+#define SHT3X_POLL_TIMEOUT      20000
+#define SHT3X_POLL_INTERVAL_MS  1000
+#define SHT3X_POLL_INTERVAL_US  250
 
-  Sample->HumidityPercent = (Sample->HumRaw / 65535.0) * 100;
+/**
+ * @brief  A late Periodic/ART sample is expected again after 1/64 of the
+ *         sample period
+ */
+#define SHT3X_PERIODIC_RETRY_SHIFT  6
 
-  TempBuff = Sample->TempRaw / 65535.0;
-  Sample->TempCelsius = (TempBuff * 175) - 45;
-  Sample->TempFahrenheit = (TempBuff * 315) - 49;
-}
+/**
+ * @brief  CRC-8 parameters
+ */
+#define SHT3X_CRC_POLYNOMIAL  0x31
+#define SHT3X_CRC_INIT        0xFF
 
-static int8_t
-SHT3x_CheckCRC(uint16_t Data, uint8_t DataCRC)
-{
-  (void)Data;
-  (void)DataCRC;
-  return 0;
-}
+/**
+ * @brief  States of asynchronous reading
+ */
+#define SHT3X_ASYNC_IDLE        0
+#define SHT3X_ASYNC_SEND_CMD    1
+#define SHT3X_ASYNC_RECEIVE     2
 
 
 
+/* Private Variables ------------------------------------------------------------*/
+#if (SHT3X_CONFIG_CRC_TABLE == 1)
 /**
- ==================================================================================
-                  ##### Public Measurement Functions #####                         
- ==================================================================================
+ * @brief  CRC-8 lookup table (Polynomial: 0x31)
  */
+static const uint8_t SHT3x_CRCTable[256] SHT3X_CONST_DATA =
+{
+  0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97,
+  0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E,
+  0x43, 0x72, 0x21, 0x10, 0x87, 0xB6, 0xE5, 0xD4,
+  0xFA, 0xCB, 0x98, 0xA9, 0x3E, 0x0F, 0x5C, 0x6D,
+  0x86, 0xB7, 0xE4, 0xD5, 0x42, 0x73, 0x20, 0x11,
+  0x3F, 0x0E, 0x5D, 0x6C, 0xFB, 0xCA, 0x99, 0xA8,
+  0xC5, 0xF4, 0xA7, 0x96, 0x01, 0x30, 0x63, 0x52,
+  0x7C, 0x4D, 0x1E, 0x2F, 0xB8, 0x89, 0xDA, 0xEB,
+  0x3D, 0x0C, 0x5F, 0x6E, 0xF9, 0xC8, 0x9B, 0xAA,
+  0x84, 0xB5, 0xE6, 0xD7, 0x40, 0x71, 0x22, 0x13,
+  0x7E, 0x4F, 0x1C, 0x2D, 0xBA, 0x8B, 0xD8, 0xE9,
+  0xC7, 0xF6, 0xA5, 0x94, 0x03, 0x32, 0x61, 0x50,
+  0xBB, 0x8A, 0xD9, 0xE8, 0x7F, 0x4E, 0x1D, 0x2C,
+  0x02, 0x33, 0x60, 0x51, 0xC6, 0xF7, 0xA4, 0x95,
+  0xF8, 0xC9, 0x9A, 0xAB, 0x3C, 0x0D, 0x5E, 0x6F,
+  0x41, 0x70, 0x23, 0x12, 0x85, 0xB4, 0xE7, 0xD6,
+  0x7A, 0x4B, 0x18, 0x29, 0xBE, 0x8F, 0xDC, 0xED,
+  0xC3, 0xF2, 0xA1, 0x90, 0x07, 0x36, 0x65, 0x54,
+  0x39, 0x08, 0x5B, 0x6A, 0xFD, 0xCC, 0x9F, 0xAE,
+  0x80, 0xB1, 0xE2, 0xD3, 0x44, 0x75, 0x26, 0x17,
+  0xFC, 0xCD, 0x9E, 0xAF, 0x38, 0x09, 0x5A, 0x6B,
+  0x45, 0x74, 0x27, 0x16, 0x81, 0xB0, 0xE3, 0xD2,
+  0xBF, 0x8E, 0xDD, 0xEC, 0x7B, 0x4A, 0x19, 0x28,
+  0x06, 0x37, 0x64, 0x55, 0xC2, 0xF3, 0xA0, 0x91,
+  0x47, 0x76, 0x25, 0x14, 0x83, 0xB2, 0xE1, 0xD0,
+  0xFE, 0xCF, 0x9C, 0xAD, 0x3A, 0x0B, 0x58, 0x69,
+  0x04, 0x35, 0x66, 0x57, 0xC0, 0xF1, 0xA2, 0x93,
+  0xBD, 0x8C, 0xDF, 0xEE, 0x79, 0x48, 0x1B, 0x2A,
+  0xC1, 0xF0, 0xA3, 0x92, 0x05, 0x34, 0x67, 0x56,
+  0x78, 0x49, 0x1A, 0x2B, 0xBC, 0x8D, 0xDE, 0xEF,
+  0x82, 0xB3, 0xE0, 0xD1, 0x46, 0x77, 0x24, 0x15,
+  0x3B, 0x0A, 0x59, 0x68, 0xFF, 0xCE, 0x9D, 0xAC
+};
+#endif
 
 /**
- * @brief  Set Measurement mode Single Shot
- * @param  Handler: Pointer to handler
- * @param  Repeatability: Specify repeatability level (See Datasheet for more 
- *                        information)
- * 
- * @retval SHT3x_Result_t
- *         - SHT3x_OK: Operation was successful.
- *         - SHT3x_FAIL: Failed to send or receive data.
- *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ * @brief  Maximum measurement duration for each SHT3x_Repeatability_t (in us)
  */
-SHT3x_Result_t
-SHT3x_SetModeSingleShot(SHT3x_Handler_t *Handler,
-                        SHT3x_Repeatability_t Repeatability)
+static const uint16_t SHT3x_MeasurementTime[3] =
 {
-  uint8_t cmd[2];
-  
-  cmd[0] = SHT3X_COMMAND_STOP_PERIODIC_MSB;
-  cmd[1] = SHT3X_COMMAND_STOP_PERIODIC_LSB;
-  if (Handler->PlatformSend(Handler->AddressI2C, cmd, 2) != 0)
-    return SHT3x_FAIL;
-
-  Handler->Mode = SHT3x_MODE_SINGLESHOT;
-  Handler->Repeatability = Repeatability;
-
-  return SHT3x_OK;
-}
-
+  SHT3X_MEASUREMENT_TIME_LOW,
+  SHT3X_MEASUREMENT_TIME_MEDIUM,
+  SHT3X_MEASUREMENT_TIME_HIGH,
+};
 
 /**
- * @brief  Set Measurement mode Periodic
- * @param  Handler: Pointer to handler
- * @param  Speed: Specify acquisition frequency
- * @param  Repeatability: Specify repeatability level (See Datasheet for more 
- *                        information)
- * 
- * @retval SHT3x_Result_t
- *         - SHT3x_OK: Operation was successful.
- *         - SHT3x_FAIL: Failed to send or receive data.
- *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ * @brief  Sample period for each SHT3x_Speed_t (in us)
  */
-SHT3x_Result_t
-SHT3x_SetModePeriodic(SHT3x_Handler_t *Handler,
-                      SHT3x_Speed_t Speed,
-                      SHT3x_Repeatability_t Repeatability)
+static const uint32_t SHT3x_SamplePeriod[5] =
 {
-  uint8_t cmd[2];
-  uint8_t ComandPeriodicMSB[5] = {0};
-  uint8_t ComandPeriodicLSB[3] = {0};
+  2000000, // SHT3x_SPEED_05MPS
+  1000000, // SHT3x_SPEED_1MPS
+  500000,  // SHT3x_SPEED_2MPS
+  250000,  // SHT3x_SPEED_4MPS
+  100000,  // SHT3x_SPEED_10MPS
+};
 
-  ComandPeriodicMSB[SHT3x_SPEED_05MPS] = SHT3X_COMMAND_PERIODIC_05MPS_MSB;
-  ComandPeriodicMSB[SHT3x_SPEED_1MPS] = SHT3X_COMMAND_PERIODIC_1MPS_MSB;
-  ComandPeriodicMSB[SHT3x_SPEED_2MPS] = SHT3X_COMMAND_PERIODIC_2MPS_MSB;
-  ComandPeriodicMSB[SHT3x_SPEED_4MPS] = SHT3X_COMMAND_PERIODIC_4MPS_MSB;
-  ComandPeriodicMSB[SHT3x_SPEED_10MPS] = SHT3X_COMMAND_PERIODIC_10MPS_MSB;
+/**
+ * @brief  Sample period of ART mode (in us)
+ */
+#define SHT3X_ART_SAMPLE_PERIOD   250000
 
-  switch (Speed)
+/**
+ * @brief  Measurement commands in single shot mode
+ *         [Clock stretching][SHT3x_Repeatability_t][MSB, LSB]
+ */
+static const uint8_t SHT3x_CommandSingleShot[2][3][2] SHT3X_CONST_DATA =
+{
   {
-  case SHT3x_SPEED_05MPS:
+    {SHT3X_COMMAND_SINGLESHOT_DISABLE_MSB, SHT3X_COMMAND_SINGLESHOT_DISABLE_LOW_LSB},
+    {SHT3X_COMMAND_SINGLESHOT_DISABLE_MSB, SHT3X_COMMAND_SINGLESHOT_DISABLE_MEDIUM_LSB},
+    {SHT3X_COMMAND_SINGLESHOT_DISABLE_MSB, SHT3X_COMMAND_SINGLESHOT_DISABLE_HIGH_LSB},
+  },
   {
-    ComandPeriodicLSB[SHT3x_REPEATABILITY_LOW] =
-        SHT3X_COMMAND_PERIODIC_05MPS_LOW_LSB;
-    ComandPeriodicLSB[SHT3x_REPEATABILITY_MEDIUM] =
-        SHT3X_COMMAND_PERIODIC_05MPS_MEDIUM_LSB;
-    ComandPeriodicLSB[SHT3x_REPEATABILITY_HIGH] =
-        SHT3X_COMMAND_PERIODIC_05MPS_HIGH_LSB;
-    break;
-  }
-  
-  case SHT3x_SPEED_1MPS:
-  {
-    ComandPeriodicLSB[SHT3x_REPEATABILITY_LOW] =
-        SHT3X_COMMAND_PERIODIC_1MPS_LOW_LSB;
-    ComandPeriodicLSB[SHT3x_REPEATABILITY_MEDIUM] =
-        SHT3X_COMMAND_PERIODIC_1MPS_MEDIUM_LSB;
-    ComandPeriodicLSB[SHT3x_REPEATABILITY_HIGH] =
-        SHT3X_COMMAND_PERIODIC_1MPS_HIGH_LSB;
-    break;
-  }
+    {SHT3X_COMMAND_SINGLESHOT_ENABLE_MSB, SHT3X_COMMAND_SINGLESHOT_ENABLE_LOW_LSB},
+    {SHT3X_COMMAND_SINGLESHOT_ENABLE_MSB, SHT3X_COMMAND_SINGLESHOT_ENABLE_MEDIUM_LSB},
+    {SHT3X_COMMAND_SINGLESHOT_ENABLE_MSB, SHT3X_COMMAND_SINGLESHOT_ENABLE_HIGH_LSB},
+  },
+};
 
-  case SHT3x_SPEED_2MPS:
+/**
+ * @brief  Measurement commands for periodic data acquisition mode
+ *         [SHT3x_Speed_t][SHT3x_Repeatability_t][MSB, LSB]
+ */
+static const uint8_t SHT3x_CommandPeriodic[5][3][2] SHT3X_CONST_DATA =
+{
   {
-    ComandPeriodicLSB[SHT3x_REPEATABILITY_LOW] =
-        SHT3X_COMMAND_PERIODIC_2MPS_LOW_LSB;
-    ComandPeriodicLSB[SHT3x_REPEATABILITY_MEDIUM] =
-        SHT3X_COMMAND_PERIODIC_2MPS_MEDIUM_LSB;
-    ComandPeriodicLSB[SHT3x_REPEATABILITY_HIGH] =
-        SHT3X_COMMAND_PERIODIC_2MPS_HIGH_LSB;
-    break;
-  }
-
-  case SHT3x_SPEED_4MPS:
+    {SHT3X_COMMAND_PERIODIC_05MPS_MSB, SHT3X_COMMAND_PERIODIC_05MPS_LOW_LSB},
+    {SHT3X_COMMAND_PERIODIC_05MPS_MSB, SHT3X_COMMAND_PERIODIC_05MPS_MEDIUM_LSB},
+    {SHT3X_COMMAND_PERIODIC_05MPS_MSB, SHT3X_COMMAND_PERIODIC_05MPS_HIGH_LSB},
+  },
   {
-    ComandPeriodicLSB[SHT3x_REPEATABILITY_LOW] =
-        SHT3X_COMMAND_PERIODIC_4MPS_LOW_LSB;
-    ComandPeriodicLSB[SHT3x_REPEATABILITY_MEDIUM] =
-        SHT3X_COMMAND_PERIODIC_4MPS_MEDIUM_LSB;
-    ComandPeriodicLSB[SHT3x_REPEATABILITY_HIGH] =
-        SHT3X_COMMAND_PERIODIC_4MPS_HIGH_LSB;
-    break;
-  }
-
-  case SHT3x_SPEED_10MPS:
+    {SHT3X_COMMAND_PERIODIC_1MPS_MSB, SHT3X_COMMAND_PERIODIC_1MPS_LOW_LSB},
+    {SHT3X_COMMAND_PERIODIC_1MPS_MSB, SHT3X_COMMAND_PERIODIC_1MPS_MEDIUM_LSB},
+    {SHT3X_COMMAND_PERIODIC_1MPS_MSB, SHT3X_COMMAND_PERIODIC_1MPS_HIGH_LSB},
+  },
   {
-    ComandPeriodicLSB[SHT3x_REPEATABILITY_LOW] =
-        SHT3X_COMMAND_PERIODIC_10MPS_LOW_LSB;
-    ComandPeriodicLSB[SHT3x_REPEATABILITY_MEDIUM] =
-        SHT3X_COMMAND_PERIODIC_10MPS_MEDIUM_LSB;
-    ComandPeriodicLSB[SHT3x_REPEATABILITY_HIGH] =
-        SHT3X_COMMAND_PERIODIC_10MPS_HIGH_LSB;
-    break;
-  }
+    {SHT3X_COMMAND_PERIODIC_2MPS_MSB, SHT3X_COMMAND_PERIODIC_2MPS_LOW_LSB},
+    {SHT3X_COMMAND_PERIODIC_2MPS_MSB, SHT3X_COMMAND_PERIODIC_2MPS_MEDIUM_LSB},
+    {SHT3X_COMMAND_PERIODIC_2MPS_MSB, SHT3X_COMMAND_PERIODIC_2MPS_HIGH_LSB},
+  },
+  {
+    {SHT3X_COMMAND_PERIODIC_4MPS_MSB, SHT3X_COMMAND_PERIODIC_4MPS_LOW_LSB},
+    {SHT3X_COMMAND_PERIODIC_4MPS_MSB, SHT3X_COMMAND_PERIODIC_4MPS_MEDIUM_LSB},
+    {SHT3X_COMMAND_PERIODIC_4MPS_MSB, SHT3X_COMMAND_PERIODIC_4MPS_HIGH_LSB},
+  },
+  {
+    {SHT3X_COMMAND_PERIODIC_10MPS_MSB, SHT3X_COMMAND_PERIODIC_10MPS_LOW_LSB},
+    {SHT3X_COMMAND_PERIODIC_10MPS_MSB, SHT3X_COMMAND_PERIODIC_10MPS_MEDIUM_LSB},
+    {SHT3X_COMMAND_PERIODIC_10MPS_MSB, SHT3X_COMMAND_PERIODIC_10MPS_HIGH_LSB},
+  },
+};
 
-  default:
-    return SHT3x_INVALID_PARAM;
-    break;
-  }
+/**
+ * @brief  Alert limit commands [SHT3x_AlertLimit_t][Read, Write]
+ */
+static const uint8_t SHT3x_CommandAlert[4][2] SHT3X_CONST_DATA =
+{
+  {SHT3X_COMMAND_ALERT_READ_HIGH_SET_LSB, SHT3X_COMMAND_ALERT_WRITE_HIGH_SET_LSB},
+  {SHT3X_COMMAND_ALERT_READ_HIGH_CLEAR_LSB, SHT3X_COMMAND_ALERT_WRITE_HIGH_CLEAR_LSB},
+  {SHT3X_COMMAND_ALERT_READ_LOW_CLEAR_LSB, SHT3X_COMMAND_ALERT_WRITE_LOW_CLEAR_LSB},
+  {SHT3X_COMMAND_ALERT_READ_LOW_SET_LSB, SHT3X_COMMAND_ALERT_WRITE_LOW_SET_LSB},
+};
 
-  cmd[0] = ComandPeriodicMSB[Speed];
-  cmd[1] = ComandPeriodicLSB[Repeatability];
 
-  if (Handler->PlatformSend(Handler->AddressI2C, cmd, 2) != 0)
-    return SHT3x_FAIL;
 
-  Handler->Mode = SHT3x_MODE_PERIODIC;
-  Handler->Speed = Speed;
-  Handler->Repeatability = Repeatability;
-  
-  return SHT3x_OK;
-}
+/**
+ ==================================================================================
+                       ##### Private Functions #####                               
+ ==================================================================================
+ */
 
+static int8_t
+SHT3x_CountTransfer(SHT3x_Handler_t *Handler, uint8_t Len, int8_t Result)
+{
+  // After a bus error the state of the sensor is not known
+  if (Result != 0 && Result != -3)
+    Handler->StatusValid = 0;
+
+#if (SHT3X_CONFIG_STATS == 1)
+  Handler->Stats.Transactions++;
+  if (Result == 0)
+    Handler->Stats.Bytes += Len;
+  else if (Result == -3)
+    Handler->Stats.Nacks++;
+  else
+    Handler->Stats.BusErrors++;
+#else
+  (void)Handler;
+  (void)Len;
+#endif
+  return Result;
+}
 
 /**
- * @brief  Set Measurement mode ART (Accelerated Response Time)
- * @param  Handler: Pointer to handler
- * @retval SHT3x_Result_t
- *         - SHT3x_OK: Operation was successful.
- *         - SHT3x_FAIL: Failed to send or receive data.
+ * @brief  Take the bus lock. Nested calls only count the depth.
  */
-SHT3x_Result_t
-SHT3x_SetModeART(SHT3x_Handler_t *Handler)
+static int8_t
+SHT3x_Lock(SHT3x_Handler_t *Handler)
 {
-  uint8_t cmd[2];
-
-  cmd[0] = SHT3X_COMMAND_ART_MSB;
-  cmd[1] = SHT3X_COMMAND_ART_LSB;
+  if (Handler->LockHeld++ || !SHT3X_HAS_LOCK(Handler))
+    return 0;
 
-  if (Handler->PlatformSend(Handler->AddressI2C, cmd, 2) != 0)
-    return SHT3x_FAIL;
-
-  Handler->Mode = SHT3x_MODE_ART;
+  if (SHT3X_CALL_LOCK(Handler) != 0)
+  {
+    Handler->LockHeld = 0;
+    return -1;
+  }
 
-  return SHT3x_OK;
+  return 0;
 }
 
+static void
+SHT3x_Unlock(SHT3x_Handler_t *Handler)
+{
+  if (--Handler->LockHeld == 0 && SHT3X_HAS_LOCK(Handler))
+    (void)SHT3X_CALL_UNLOCK(Handler);
+}
 
 /**
- * @brief  Read a sample
- * @note   In Single Shot mode, the function starts measuring and waits up to
- *         20ms to finish.
- *
- * @param  Handler: Pointer to handler
- * @param  Sample: Pointer to sample buffer
- * @retval SHT3x_Result_t
- *         - SHT3x_OK: Operation was successful.
- *         - SHT3x_FAIL: Failed to send or receive data.
- *         - SHT3x_CRC_ERROR: CRC check error.
+ * @brief  Check if the circuit breaker lets the handler access the bus
  */
-SHT3x_Result_t
-SHT3x_ReadSample(SHT3x_Handler_t *Handler, SHT3x_Sample_t *Sample)
+static uint8_t
+SHT3x_BreakerAllow(SHT3x_Handler_t *Handler)
 {
-  uint8_t cmd[2];
-  uint8_t Buffer[6] = {0};
-  int8_t PlatformResult = 0;
+  if (!Handler->BreakerOpen)
+    return 1;
 
-  if (Handler->Mode == SHT3x_MODE_SINGLESHOT)
-  {
-    cmd[0] = SHT3X_COMMAND_SINGLESHOT_DISABLE_MSB;
-    switch (Handler->Repeatability)
-    {
-    case SHT3x_REPEATABILITY_LOW:
-      cmd[1] = SHT3X_COMMAND_SINGLESHOT_DISABLE_LOW_LSB;
-      break;
+  // After the backoff time one attempt is allowed (half-open)
+  if ((int32_t)(SHT3X_CALL_GET_TIME(Handler) - Handler->BreakerRetry) >= 0)
+    return 1;
 
-    case SHT3x_REPEATABILITY_MEDIUM:
-      cmd[1] = SHT3X_COMMAND_SINGLESHOT_DISABLE_MEDIUM_LSB;
-      break;
+  SHT3X_STATS_INC(Handler, Rejected);
+  return 0;
+}
 
-    case SHT3x_REPEATABILITY_HIGH:
-      cmd[1] = SHT3X_COMMAND_SINGLESHOT_DISABLE_HIGH_LSB;
-      break;
+/**
+ * @brief  Count consecutive failures and trip the circuit breaker
+ * @param  NackFails: 1 if -3 is a failure (commands), 0 if it means no data
+ */
+static void
+SHT3x_BreakerUpdate(SHT3x_Handler_t *Handler, int8_t Result, uint8_t NackFails)
+{
+  if (!Handler->FailLimit)
+    return;
 
-    default:
-      return SHT3x_INVALID_PARAM;
-      break;
-    }
-    if (Handler->PlatformSend(Handler->AddressI2C, cmd, 2) != 0)
-      return SHT3x_FAIL;
+  if (Result == 0)
+  {
+    Handler->FailCount = 0;
+    Handler->BreakerOpen = 0;
+    Handler->Backoff = Handler->BackoffMin;
+    return;
+  }
 
-    for (uint8_t Counter = 0; Counter < 20; Counter++)
-    {
-      if (Handler->PlatformReceive(Handler->AddressI2C, Buffer, 6) == 0)
-        break;
+  if (Result == -3 && !NackFails)
+    return;
 
-      Handler->PlatformDelay(1);
-    }
+  // A failure in half-open state trips the breaker again at once
+  if (++Handler->FailCount < Handler->FailLimit && !Handler->BreakerOpen)
+    return;
 
-    if (Buffer[2] == 0 && Buffer[5] == 0)
-      return SHT3x_FAIL;
-  }
-  else
+  Handler->FailCount = 0;
+  if (SHT3X_HAS_BUS_RECOVERY(Handler))
   {
-    cmd[0] = SHT3X_COMMAND_FETCH_DATA_MSB;
-    cmd[1] = SHT3X_COMMAND_FETCH_DATA_LSB;
-
-    PlatformResult = Handler->PlatformSend(Handler->AddressI2C, cmd, 2);
-    if (PlatformResult != 0)
-      return SHT3x_FAIL;
+    (void)SHT3X_CALL_BUS_RECOVERY(Handler);
+    SHT3X_STATS_INC(Handler, Recoveries);
+  }
 
-    PlatformResult = Handler->PlatformReceive(Handler->AddressI2C, Buffer, 6);
-    if (PlatformResult == -3)
-      return SHT3x_NO_DATA;
-    else if (PlatformResult != 0)
-      return SHT3x_FAIL;
+  if (SHT3X_HAS_GET_TIME(Handler) && Handler->Backoff)
+  {
+    Handler->BreakerOpen = 1;
+    Handler->BreakerRetry = SHT3X_CALL_GET_TIME(Handler) +
+                            Handler->Backoff * 1000;
+    Handler->Backoff = (Handler->Backoff > Handler->BackoffMax / 2) ?
+                       Handler->BackoffMax : Handler->Backoff * 2;
   }
+}
 
-  Sample->TempRaw = (Buffer[0] << 8) | Buffer[1];
-  Sample->HumRaw = (Buffer[3] << 8) | Buffer[4];
+static int8_t
+SHT3x_Send(SHT3x_Handler_t *Handler, uint8_t *Data, uint8_t Len)
+{
+  int8_t Result;
 
-  if (Handler->PlatformCRC(Sample->TempRaw, Buffer[2]) != 0)
-    return SHT3x_CRC_ERROR;
-  
-  if (Handler->PlatformCRC(Sample->HumRaw, Buffer[5]) != 0)
-    return SHT3x_CRC_ERROR;
+  if (!SHT3x_BreakerAllow(Handler))
+    return -1;
 
-  SHT3x_ConvSample(Sample);
+  if (SHT3x_Lock(Handler) != 0)
+    return -1;
 
-  return SHT3x_OK;
+  Result = SHT3x_CountTransfer(Handler, Len,
+      SHT3X_CALL_SEND(Handler, Handler->AddressI2C, Data, Len));
+  SHT3x_BreakerUpdate(Handler, Result, 1);
+
+  SHT3x_Unlock(Handler);
+  return Result;
 }
 
+static int8_t
+SHT3x_Receive(SHT3x_Handler_t *Handler, uint8_t *Data, uint8_t Len)
+{
+  int8_t Result;
 
+  if (!SHT3x_BreakerAllow(Handler))
+    return -1;
 
-/**
- ==================================================================================
-               ##### Public Control and Status Functions #####                     
- ==================================================================================
- */
+  if (SHT3x_Lock(Handler) != 0)
+    return -1;
+
+  Result = SHT3x_CountTransfer(Handler, Len,
+      SHT3X_CALL_RECEIVE(Handler, Handler->AddressI2C, Data, Len));
+  SHT3x_BreakerUpdate(Handler, Result, 0);
+
+  SHT3x_Unlock(Handler);
+  return Result;
+}
 
 /**
- * @brief  Initializer function
- * @param  Handler: Pointer to handler
- * @param  Address: The address depends on ADDR pin state. You should use one of
- *                  this options:
- *         - 0: This address used when ADDR is connected VSS
- *         - 1: This address used when ADDR is connected VDD
- * 
- * @retval SHT3x_Result_t
- *         - SHT3x_OK: Operation was successful.
- *         - SHT3x_FAIL: Failed to send or receive data.
- *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ * @brief  Send a command and receive the response
+ * @note   A failure of the send phase is always reported as -1, so -3 means
+ *         the read header is not acknowledged.
+ * @note   The bus lock is held across both phases.
  */
-SHT3x_Result_t
-SHT3x_Init(SHT3x_Handler_t *Handler, uint8_t Address)
+static int8_t
+SHT3x_SendReceive(SHT3x_Handler_t *Handler, uint8_t *Command,
+                  uint8_t *Data, uint8_t Len)
 {
-  uint8_t cmd[2];
+  int8_t Result = -1;
 
-  SHT3x_SetAddressI2C(Handler, Address);
-
-  if (!Handler->PlatformSend ||
-      !Handler->PlatformReceive ||
-      !Handler->PlatformDelay)
-    return SHT3x_INVALID_PARAM;
+  if (!SHT3x_BreakerAllow(Handler))
+    return -1;
 
-  if (!Handler->PlatformCRC)
-    Handler->PlatformCRC = SHT3x_CheckCRC;
+  if (SHT3x_Lock(Handler) != 0)
+    return -1;
 
-  if (Handler->PlatformInit)
+  if (SHT3X_HAS_SEND_RECEIVE(Handler))
   {
-    if (Handler->PlatformInit() != 0)
-      return SHT3x_FAIL;
+    Result = SHT3x_CountTransfer(Handler, 2 + Len,
+        SHT3X_CALL_SEND_RECEIVE(Handler, Handler->AddressI2C,
+                                Command, 2, Data, Len));
+    SHT3x_BreakerUpdate(Handler, Result, 0);
+  }
+  else if (SHT3x_Send(Handler, Command, 2) == 0)
+  {
+    Result = SHT3x_Receive(Handler, Data, Len);
   }
 
-  SHT3x_SetModeSingleShot(Handler, SHT3x_REPEATABILITY_LOW);
-  
-  cmd[0] = SHT3X_COMMAND_SOFT_RESET_MSB;
-  cmd[1] = SHT3X_COMMAND_SOFT_RESET_LSB;
-  if (Handler->PlatformSend(Handler->AddressI2C, cmd, 2) != 0)
-      return SHT3x_FAIL;
+  SHT3x_Unlock(Handler);
+  return Result;
+}
 
-  Handler->PlatformDelay(2);
-  
-  return SHT3x_OK;
+static void
+SHT3x_LoadCommand(uint8_t *Command, const uint8_t *TableEntry)
+{
+  Command[0] = SHT3X_READ_CONST_BYTE(TableEntry[0]);
+  Command[1] = SHT3X_READ_CONST_BYTE(TableEntry[1]);
 }
 
-/**
- * @brief  Deinitialize function
- * @param  Handler: Pointer to handler
- * @retval SHT3x_Result_t
- *         - SHT3x_OK: Operation was successful.
+static uint32_t
+SHT3x_GetTime(SHT3x_Handler_t *Handler)
+{
+  return SHT3X_CALL_GET_TIME(Handler);
+}
+
+static void
+SHT3x_DelayUs(SHT3x_Handler_t *Handler, uint32_t Delay)
+{
+  uint32_t DelayMs;
+
+  if (SHT3X_HAS_DELAY_US(Handler))
+  {
+    if (Delay)
+      SHT3X_CALL_DELAY_US(Handler, Delay);
+    return;
+  }
+
+  DelayMs = (Delay + 999) / 1000;
+  for (; DelayMs > 255; DelayMs -= 255)
+    SHT3X_CALL_DELAY(Handler, 255);
+  if (DelayMs)
+    SHT3X_CALL_DELAY(Handler, (uint8_t)DelayMs);
+}
+
+static void
+SHT3x_StartPeriodic(SHT3x_Handler_t *Handler, uint32_t SamplePeriod)
+{
+  Handler->SamplePeriod = SamplePeriod;
+  Handler->SampleLate = 0;
+  if (!SHT3X_HAS_GET_TIME(Handler))
+    return;
+
+  Handler->PeriodicStart = SHT3x_GetTime(Handler);
+  Handler->SampleDue = Handler->PeriodicStart +
+      SHT3x_GetMeasurementTime((SHT3X_MODE(Handler) == SHT3x_MODE_ART) ?
+                               SHT3x_REPEATABILITY_HIGH :
+                               SHT3X_REPEATABILITY(Handler));
+}
+
+static void
+SHT3x_PeriodicNoData(SHT3x_Handler_t *Handler)
+{
+  uint32_t Now;
+
+  if (!SHT3X_HAS_GET_TIME(Handler))
+    return;
+
+  // No data after the due time means the sample grid is early
+  Now = SHT3x_GetTime(Handler);
+  if ((int32_t)(Now - Handler->SampleDue) >= 0)
+  {
+    Handler->SampleLate = 1;
+    Handler->SampleDue = Now +
+        (Handler->SamplePeriod >> SHT3X_PERIODIC_RETRY_SHIFT);
+  }
+}
+
+static void
+SHT3x_PeriodicFetched(SHT3x_Handler_t *Handler)
+{
+  uint32_t Now;
+
+  if (!SHT3X_HAS_GET_TIME(Handler))
+    return;
+
+  Now = SHT3x_GetTime(Handler);
+  Handler->LastFetch = Now;
+
+  if (Handler->SampleLate || (int32_t)(Now - Handler->SampleDue) < 0)
+  {
+    // The sample did not land on the grid. It landed before now, so the
+    // next one is at most one period away.
+    Handler->SampleDue = Now + Handler->SamplePeriod;
+    Handler->SampleLate = 0;
+    return;
+  }
+
+  // Stay on the grid. Skip the samples that were overwritten.
+  while ((int32_t)(Now - Handler->SampleDue) >= 0)
+    Handler->SampleDue += Handler->SamplePeriod;
+}
+#if (SHT3X_CONFIG_FLOAT == 1)
+static void
+SHT3x_ConvertBatchKernel(const uint16_t *restrict Raw, float *restrict Out,
+                         size_t Len, float Scale, float Offset)
+{
+  for (size_t i = 0; i < Len; i++)
+    Out[i] = (float)Raw[i] * Scale + Offset;
+}
+#endif
+
+static uint8_t
+SHT3x_UpdateCRC(uint8_t CRC, uint8_t Data)
+{
+#if (SHT3X_CONFIG_CRC_TABLE == 1)
+  return SHT3X_READ_CONST_BYTE(SHT3x_CRCTable[CRC ^ Data]);
+#else
+  CRC ^= Data;
+  for (uint8_t Bit = 0; Bit < 8; Bit++)
+  {
+    if (CRC & 0x80)
+      CRC = (CRC << 1) ^ SHT3X_CRC_POLYNOMIAL;
+    else
+      CRC <<= 1;
+  }
+  return CRC;
+#endif
+}
+
+/**
+ * @brief  Check CRC of received data. Data consists of Words items of
+ *         2 bytes data followed by 1 byte CRC.
+ */
+static SHT3x_Result_t
+SHT3x_CheckCRC(SHT3x_Handler_t *Handler, uint8_t *Buffer, uint8_t Words)
+{
+  uint8_t CRC;
+
+  if (Handler->PlatformCRC)
+  {
+    for (; Words > 0; Words--, Buffer += 3)
+    {
+      if (Handler->PlatformCRC((Buffer[0] << 8) | Buffer[1], Buffer[2]) != 0)
+      {
+        SHT3X_STATS_INC(Handler, CRCErrors);
+        Handler->StatusValid = 0;
+        return SHT3x_CRC_ERROR;
+      }
+    }
+    return SHT3x_OK;
+  }
+
+  for (; Words > 0; Words--, Buffer += 3)
+  {
+    CRC = SHT3x_UpdateCRC(SHT3X_CRC_INIT, Buffer[0]);
+    CRC = SHT3x_UpdateCRC(CRC, Buffer[1]);
+    if (CRC != Buffer[2])
+    {
+      SHT3X_STATS_INC(Handler, CRCErrors);
+      Handler->StatusValid = 0;
+      return SHT3x_CRC_ERROR;
+    }
+  }
+
+  return SHT3x_OK;
+}
+
+static SHT3x_Result_t
+SHT3x_ParseSample(SHT3x_Handler_t *Handler,
+                  uint8_t *Buffer, SHT3x_Sample_t *Sample)
+{
+  if (SHT3x_CheckCRC(Handler, Buffer, 2) != SHT3x_OK)
+    return SHT3x_CRC_ERROR;
+
+  if (Handler->StatusRefreshEvery &&
+      ++Handler->StatusSamples >= Handler->StatusRefreshEvery)
+    Handler->StatusValid = 0;
+
+  Sample->TempRaw = (Buffer[0] << 8) | Buffer[1];
+  Sample->HumRaw = (Buffer[3] << 8) | Buffer[4];
+
+  SHT3x_ConvertSample(Sample, Handler->Conversion);
+
+  return SHT3x_OK;
+}
+
+
+
+/**
+ * @brief  Set the address and the platform functions of a handler and reset
+ *         its state. PlatformInit is not called.
+ */
+static SHT3x_Result_t
+SHT3x_PrepareHandler(SHT3x_Handler_t *Handler, uint8_t Address)
+{
+  if (SHT3x_SetAddressI2C(Handler, Address) != SHT3x_OK)
+    return SHT3x_INVALID_PARAM;
+
+#if (SHT3X_CONFIG_STATIC_PLATFORM == 1)
+  Handler->PlatformInit = SHT3X_STATIC_INIT;
+  Handler->PlatformDeInit = SHT3X_STATIC_DEINIT;
+  Handler->PlatformSend = SHT3X_STATIC_SEND;
+  Handler->PlatformReceive = SHT3X_STATIC_RECEIVE;
+  Handler->PlatformDelay = SHT3X_STATIC_DELAY;
+  Handler->PlatformDelayUs = SHT3X_STATIC_DELAY_US;
+  Handler->PlatformGetTime = SHT3X_STATIC_GET_TIME;
+  Handler->PlatformSendReceive = SHT3X_STATIC_SEND_RECEIVE;
+  Handler->PlatformProbe = SHT3X_STATIC_PROBE;
+  Handler->PlatformBusRecovery = SHT3X_STATIC_BUS_RECOVERY;
+  Handler->PlatformLock = SHT3X_STATIC_LOCK;
+  Handler->PlatformUnlock = SHT3X_STATIC_UNLOCK;
+#else
+  if (!Handler->PlatformSend ||
+      !Handler->PlatformReceive ||
+      !Handler->PlatformDelay)
+    return SHT3x_INVALID_PARAM;
+#endif
+
+  Handler->Conversion = SHT3x_CONVERSION_ALL;
+  Handler->StatusValid = 0;
+  Handler->FailCount = 0;
+  Handler->BreakerOpen = 0;
+  Handler->Backoff = Handler->BackoffMin;
+  Handler->LockHeld = 0;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Common part of SHT3x_Init() and SHT3x_InitMany()
+ */
+static SHT3x_Result_t
+SHT3x_InitHandler(SHT3x_Handler_t *Handler, uint8_t Address)
+{
+  if (SHT3x_PrepareHandler(Handler, Address) != SHT3x_OK)
+    return SHT3x_INVALID_PARAM;
+
+  if (SHT3X_HAS_INIT(Handler))
+  {
+    if (SHT3X_CALL_INIT(Handler) != 0)
+      return SHT3x_FAIL;
+  }
+
+  return SHT3x_OK;
+}
+
+
+static SHT3x_Result_t
+SHT3x_SoftReset(SHT3x_Handler_t *Handler)
+{
+  uint8_t cmd[2];
+
+  cmd[0] = SHT3X_COMMAND_SOFT_RESET_MSB;
+  cmd[1] = SHT3X_COMMAND_SOFT_RESET_LSB;
+  if (SHT3x_Send(Handler, cmd, 2) != 0)
+    return SHT3x_FAIL;
+
+  Handler->StatusValid = 0;
+
+  return SHT3x_OK;
+}
+
+
+static uint8_t
+SHT3x_SameBus(const SHT3x_Handler_t *Handler1, const SHT3x_Handler_t *Handler2)
+{
+  return (Handler1->Context == Handler2->Context &&
+          Handler1->PlatformSend == Handler2->PlatformSend) ? 1 : 0;
+}
+
+
+/**
+ * @brief  Select the mode of a new handler (Single Shot if it is allowed)
+ */
+static SHT3x_Result_t
+SHT3x_SetDefaultMode(SHT3x_Handler_t *Handler)
+{
+#if (SHT3X_CONFIG_STATIC_MODE > 0)
+  (void)Handler;
+  return SHT3x_OK;
+#else
+  return SHT3x_SetModeSingleShot(Handler, SHT3X_DEFAULT_REPEATABILITY);
+#endif
+}
+
+
+/**
+ * @brief  Fetch the sample until it is ready or Timeout (in us) is passed
+ */
+static SHT3x_Result_t
+SHT3x_PollSample(SHT3x_Handler_t *Handler, SHT3x_Sample_t *Sample,
+                 uint32_t Timeout)
+{
+  SHT3x_Result_t Result = SHT3x_OK;
+  uint32_t Interval = SHT3X_HAS_DELAY_US(Handler) ?
+                      SHT3X_POLL_INTERVAL_US : SHT3X_POLL_INTERVAL_MS;
+
+  for (uint32_t Waited = 0; Waited < Timeout; Waited += Interval)
+  {
+    Result = SHT3x_FetchSample(Handler, Sample);
+    if (Result != SHT3x_NO_DATA)
+      return Result;
+
+    SHT3X_STATS_INC(Handler, PollRetries);
+    SHT3x_DelayUs(Handler, Interval);
+  }
+
+  return SHT3x_NO_DATA;
+}
+
+
+/**
+ * @brief  Measure with clock stretching. The command and the read are one
+ *         sequence under the bus lock.
+ */
+static SHT3x_Result_t
+SHT3x_ReadSampleStretching(SHT3x_Handler_t *Handler, SHT3x_Sample_t *Sample)
+{
+  uint8_t Buffer[6] = {0};
+  SHT3x_Result_t Result = SHT3x_OK;
+
+  if (SHT3x_Lock(Handler) != 0)
+    return SHT3x_FAIL;
+
+  Result = SHT3x_StartMeasurement(Handler);
+  if (Result == SHT3x_OK)
+  {
+    Handler->MeasurementPending = 0;
+    if (SHT3x_Receive(Handler, Buffer, 6) != 0)
+      Result = SHT3x_FAIL;
+  }
+
+  SHT3x_Unlock(Handler);
+
+  if (Result != SHT3x_OK)
+    return Result;
+
+  return SHT3x_ParseSample(Handler, Buffer, Sample);
+}
+
+
+static SHT3x_Result_t
+SHT3x_ReadSampleBlocking(SHT3x_Handler_t *Handler, SHT3x_Sample_t *Sample)
+{
+  SHT3x_Result_t Result = SHT3x_OK;
+
+  if (SHT3X_MODE(Handler) == SHT3x_MODE_SINGLESHOT)
+  {
+    if (Handler->ClockStretching)
+      return SHT3x_ReadSampleStretching(Handler, Sample);
+
+    Result = SHT3x_StartMeasurement(Handler);
+    if (Result != SHT3x_OK)
+      return Result;
+
+    // Wait for the conversion at once and poll only for the rest of the
+    // timeout (the measurement time is at most 15ms)
+    Result = SHT3x_PollSample(Handler, Sample,
+                              SHT3X_POLL_TIMEOUT - SHT3x_WaitMeasurement(Handler));
+    if (Result != SHT3x_NO_DATA)
+      return Result;
+
+    Handler->MeasurementPending = 0;
+    return SHT3x_FAIL;
+  }
+
+  if (!Handler->FetchWait || !SHT3X_HAS_GET_TIME(Handler))
+    return SHT3x_FetchSample(Handler, Sample);
+
+  SHT3x_DelayUs(Handler, SHT3x_NextSampleDueIn(Handler));
+  return SHT3x_PollSample(Handler, Sample, SHT3X_POLL_TIMEOUT);
+}
+
+static void
+SHT3x_AsyncFinish(SHT3x_Handler_t *Handler, SHT3x_Result_t Result)
+{
+  SHT3x_AsyncCallback_t Callback = Handler->AsyncCallback;
+
+  Handler->AsyncState = SHT3X_ASYNC_IDLE;
+  if (Callback)
+    Callback(Handler, Result);
+}
+
+static void
+SHT3x_AsyncDone(void *Arg, int8_t PlatformResult)
+{
+  SHT3x_Handler_t *Handler = (SHT3x_Handler_t *)Arg;
+
+  SHT3x_CountTransfer(Handler,
+                      (Handler->AsyncState == SHT3X_ASYNC_SEND_CMD) ? 2 : 6,
+                      PlatformResult);
+
+  if (Handler->AsyncState == SHT3X_ASYNC_SEND_CMD)
+  {
+    if (PlatformResult != 0)
+    {
+      SHT3x_AsyncFinish(Handler, SHT3x_FAIL);
+      return;
+    }
+
+    Handler->AsyncState = SHT3X_ASYNC_RECEIVE;
+    if (Handler->PlatformTransferAsync(Handler->Context, Handler->AddressI2C,
+                                       Handler->AsyncBuffer, 6, 1,
+                                       SHT3x_AsyncDone, Handler) != 0)
+      SHT3x_AsyncFinish(Handler, SHT3x_FAIL);
+    return;
+  }
+
+  if (Handler->AsyncState != SHT3X_ASYNC_RECEIVE)
+    return;
+
+  if (SHT3X_MODE(Handler) == SHT3x_MODE_SINGLESHOT)
+  {
+    // Same as SHT3x_FetchSample(): any failure means the data is not ready
+    if (PlatformResult != 0)
+    {
+      SHT3X_STATS_INC(Handler, NoData);
+      SHT3x_AsyncFinish(Handler, SHT3x_NO_DATA);
+      return;
+    }
+    Handler->MeasurementPending = 0;
+  }
+  else if (PlatformResult == -3)
+  {
+    SHT3X_STATS_INC(Handler, NoData);
+    SHT3x_PeriodicNoData(Handler);
+    SHT3x_AsyncFinish(Handler, SHT3x_NO_DATA);
+    return;
+  }
+  else if (PlatformResult != 0)
+  {
+    SHT3x_AsyncFinish(Handler, SHT3x_FAIL);
+    return;
+  }
+  else
+  {
+    SHT3x_PeriodicFetched(Handler);
+  }
+
+  SHT3x_AsyncFinish(Handler, SHT3x_ParseSample(Handler, Handler->AsyncBuffer,
+                                               Handler->AsyncSample));
+}
+
+
+
+/**
+ ==================================================================================
+                  ##### Public Measurement Functions #####                         
+ ==================================================================================
+ */
+
+/**
+ * @brief  Set Measurement mode Single Shot
+ * @param  Handler: Pointer to handler
+ * @param  Repeatability: Specify repeatability level (See Datasheet for more 
+ *                        information)
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_SetModeSingleShot(SHT3x_Handler_t *Handler,
+                        SHT3x_Repeatability_t Repeatability)
+{
+  uint8_t cmd[2];
+
+  if (Repeatability > SHT3x_REPEATABILITY_HIGH ||
+      !SHT3X_MODE_ALLOWED(SHT3x_MODE_SINGLESHOT) ||
+      !SHT3X_REPEATABILITY_ALLOWED(Repeatability))
+    return SHT3x_INVALID_PARAM;
+  
+  cmd[0] = SHT3X_COMMAND_STOP_PERIODIC_MSB;
+  cmd[1] = SHT3X_COMMAND_STOP_PERIODIC_LSB;
+  if (SHT3x_Send(Handler, cmd, 2) != 0)
+    return SHT3x_FAIL;
+
+  Handler->Mode = SHT3x_MODE_SINGLESHOT;
+  Handler->Repeatability = Repeatability;
+  SHT3x_LoadCommand(Handler->Command,
+                    SHT3x_CommandSingleShot[Handler->ClockStretching ? 1 : 0]
+                                           [Repeatability]);
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Set Measurement mode Periodic
+ * @param  Handler: Pointer to handler
+ * @param  Speed: Specify acquisition frequency
+ * @param  Repeatability: Specify repeatability level (See Datasheet for more 
+ *                        information)
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_SetModePeriodic(SHT3x_Handler_t *Handler,
+                      SHT3x_Speed_t Speed,
+                      SHT3x_Repeatability_t Repeatability)
+{
+  uint8_t cmd[2];
+
+  if (Speed > SHT3x_SPEED_10MPS ||
+      Repeatability > SHT3x_REPEATABILITY_HIGH ||
+      !SHT3X_MODE_ALLOWED(SHT3x_MODE_PERIODIC) ||
+      !SHT3X_REPEATABILITY_ALLOWED(Repeatability))
+    return SHT3x_INVALID_PARAM;
+
+  SHT3x_LoadCommand(cmd, SHT3x_CommandPeriodic[Speed][Repeatability]);
+  if (SHT3x_Send(Handler, cmd, 2) != 0)
+    return SHT3x_FAIL;
+
+  Handler->Mode = SHT3x_MODE_PERIODIC;
+  Handler->Speed = Speed;
+  Handler->Repeatability = Repeatability;
+  SHT3x_StartPeriodic(Handler, SHT3x_SamplePeriod[Speed]);
+  Handler->Command[0] = SHT3X_COMMAND_FETCH_DATA_MSB;
+  Handler->Command[1] = SHT3X_COMMAND_FETCH_DATA_LSB;
+  
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Set Measurement mode ART (Accelerated Response Time)
+ * @param  Handler: Pointer to handler
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_INVALID_PARAM: ART mode is not allowed by
+ *           SHT3X_CONFIG_STATIC_MODE.
+ */
+SHT3x_Result_t
+SHT3x_SetModeART(SHT3x_Handler_t *Handler)
+{
+  uint8_t cmd[2];
+
+  if (!SHT3X_MODE_ALLOWED(SHT3x_MODE_ART))
+    return SHT3x_INVALID_PARAM;
+
+  cmd[0] = SHT3X_COMMAND_ART_MSB;
+  cmd[1] = SHT3X_COMMAND_ART_LSB;
+
+  if (SHT3x_Send(Handler, cmd, 2) != 0)
+    return SHT3x_FAIL;
+
+  Handler->Mode = SHT3x_MODE_ART;
+  SHT3x_StartPeriodic(Handler, SHT3X_ART_SAMPLE_PERIOD);
+  Handler->Command[0] = SHT3X_COMMAND_FETCH_DATA_MSB;
+  Handler->Command[1] = SHT3X_COMMAND_FETCH_DATA_LSB;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Enable or disable clock stretching in Single Shot mode
+ * @note   When clock stretching is enabled, the sensor holds SCL low until the
+ *         measurement is finished. So SHT3x_ReadSample() uses a single read
+ *         transaction instead of polling. The platform layer must support
+ *         clock stretching for up to 15ms.
+ *
+ * @param  Handler: Pointer to handler
+ * @param  ClockStretching: 
+ *         - 0: Disable clock stretching
+ *         - 1: Enable clock stretching
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ */
+SHT3x_Result_t
+SHT3x_SetClockStretching(SHT3x_Handler_t *Handler, uint8_t ClockStretching)
+{
+  Handler->ClockStretching = ClockStretching ? 1 : 0;
+  if (SHT3X_MODE(Handler) == SHT3x_MODE_SINGLESHOT)
+    SHT3x_LoadCommand(Handler->Command,
+                      SHT3x_CommandSingleShot[Handler->ClockStretching]
+                                             [SHT3X_REPEATABILITY(Handler)]);
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Enable or disable waiting for the next sample in Periodic and ART
+ *         mode
+ * @note   When it is enabled and PlatformGetTime is set, SHT3x_ReadSample()
+ *         waits until SHT3x_NextSampleDueIn() elapses before touching the
+ *         bus, so fetches are not wasted on NO_DATA responses.
+ *
+ * @param  Handler: Pointer to handler
+ * @param  FetchWait: 
+ *         - 0: Fetch immediately (SHT3x_NO_DATA if no new sample is ready)
+ *         - 1: Wait for the next sample
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ */
+SHT3x_Result_t
+SHT3x_SetFetchWait(SHT3x_Handler_t *Handler, uint8_t FetchWait)
+{
+  Handler->FetchWait = FetchWait ? 1 : 0;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Select the conversions done by SHT3x_ReadSample() and
+ *         SHT3x_FetchSample()
+ * @note   SHT3x_Init() selects SHT3x_CONVERSION_ALL. Use SHT3x_CONVERSION_RAW
+ *         to fill only the raw fields and convert later by
+ *         SHT3x_ConvertSample().
+ *
+ * @param  Handler: Pointer to handler
+ * @param  Conversion: Combination of SHT3x_Conversion_t flags
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_SetConversion(SHT3x_Handler_t *Handler, uint8_t Conversion)
+{
+  if (Conversion & ~SHT3x_CONVERSION_ALL)
+    return SHT3x_INVALID_PARAM;
+
+  Handler->Conversion = Conversion;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Read a sample
+ * @note   In Single Shot mode, the function starts measuring and waits up to
+ *         20ms to finish. If clock stretching is enabled, the sensor holds
+ *         the bus until the measurement is finished.
+ *
+ * @param  Handler: Pointer to handler
+ * @param  Sample: Pointer to sample buffer
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ *         - SHT3x_NO_DATA: No measurement data is present.
+ */
+SHT3x_Result_t
+SHT3x_ReadSample(SHT3x_Handler_t *Handler, SHT3x_Sample_t *Sample)
+{
+#if (SHT3X_CONFIG_STATS == 1)
+  uint32_t StartTime = 0;
+  uint32_t Latency = 0;
+  SHT3x_Result_t Result = SHT3x_OK;
+
+  if (SHT3X_HAS_GET_TIME(Handler))
+    StartTime = SHT3x_GetTime(Handler);
+
+  Result = SHT3x_ReadSampleBlocking(Handler, Sample);
+  if (Result != SHT3x_OK)
+    return Result;
+
+  Handler->Stats.Reads++;
+  if (SHT3X_HAS_GET_TIME(Handler))
+  {
+    Latency = SHT3x_GetTime(Handler) - StartTime;
+    if (Handler->Stats.Reads == 1 || Latency < Handler->Stats.LatencyMin)
+      Handler->Stats.LatencyMin = Latency;
+    if (Latency > Handler->Stats.LatencyMax)
+      Handler->Stats.LatencyMax = Latency;
+    Handler->Stats.LatencyTotal += Latency;
+  }
+
+  return Result;
+#else
+  return SHT3x_ReadSampleBlocking(Handler, Sample);
+#endif
+}
+
+
+/**
+ * @brief  Start a measurement in Single Shot mode and return immediately
+ * @note   Use SHT3x_IsReady() and SHT3x_FetchSample() to get the result.
+ *
+ * @param  Handler: Pointer to handler
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_INVALID_PARAM: Mode is not Single Shot.
+ */
+SHT3x_Result_t
+SHT3x_StartMeasurement(SHT3x_Handler_t *Handler)
+{
+  if (SHT3X_MODE(Handler) != SHT3x_MODE_SINGLESHOT)
+    return SHT3x_INVALID_PARAM;
+
+  Handler->MeasurementPending = 0;
+  if (SHT3x_Send(Handler, Handler->Command, 2) != 0)
+    return SHT3x_FAIL;
+
+  if (SHT3X_HAS_GET_TIME(Handler))
+    Handler->MeasurementDeadline = SHT3x_GetTime(Handler) +
+        SHT3x_GetMeasurementTime(SHT3X_REPEATABILITY(Handler));
+  Handler->MeasurementPending = 1;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Check if the measurement started by SHT3x_StartMeasurement() is
+ *         finished
+ * @note   This function never accesses the bus. If PlatformGetTime is not
+ *         set, the driver can not track the conversion time and this
+ *         function always reports ready.
+ *
+ * @param  Handler: Pointer to handler
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Measurement is finished.
+ *         - SHT3x_NO_DATA: Measurement is still in progress.
+ *         - SHT3x_INVALID_PARAM: No measurement is in progress.
+ */
+SHT3x_Result_t
+SHT3x_IsReady(SHT3x_Handler_t *Handler)
+{
+  if (!Handler->MeasurementPending)
+    return SHT3x_INVALID_PARAM;
+
+  if (!SHT3X_HAS_GET_TIME(Handler))
+    return SHT3x_OK;
+
+  if ((int32_t)(SHT3x_GetTime(Handler) - Handler->MeasurementDeadline) < 0)
+    return SHT3x_NO_DATA;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Abandon the measurement started by SHT3x_StartMeasurement()
+ * @note   Use it when the result is no longer needed (e.g. the sensor did not
+ *         finish in time). The bus is not accessed.
+ *
+ * @param  Handler: Pointer to handler
+ * @retval None
+ */
+void
+SHT3x_CancelMeasurement(SHT3x_Handler_t *Handler)
+{
+  Handler->MeasurementPending = 0;
+}
+
+
+/**
+ * @brief  Fetch the result of a measurement
+ * @note   In Single Shot mode, the measurement must be started by
+ *         SHT3x_StartMeasurement(). If PlatformGetTime is set and the
+ *         conversion is not finished yet, the bus is not accessed.
+ * @note   In Periodic and ART modes, this function is the same as
+ *         SHT3x_ReadSample().
+ *
+ * @param  Handler: Pointer to handler
+ * @param  Sample: Pointer to sample buffer
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_INVALID_PARAM: No measurement is in progress.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ *         - SHT3x_NO_DATA: No measurement data is present.
+ */
+SHT3x_Result_t
+SHT3x_FetchSample(SHT3x_Handler_t *Handler, SHT3x_Sample_t *Sample)
+{
+  uint8_t Buffer[6] = {0};
+  int8_t PlatformResult = 0;
+  SHT3x_Result_t Result = SHT3x_OK;
+
+  if (SHT3X_MODE(Handler) == SHT3x_MODE_SINGLESHOT)
+  {
+    Result = SHT3x_IsReady(Handler);
+    if (Result == SHT3x_NO_DATA)
+      SHT3X_STATS_INC(Handler, NoData);
+    if (Result != SHT3x_OK)
+      return Result;
+
+    // Without clock stretching, the sensor doesn't ACK the read header while
+    // it is measuring. Not all platforms report it as -3, so any failure is
+    // treated as no data.
+    if (SHT3x_Receive(Handler, Buffer, 6) != 0)
+    {
+      SHT3X_STATS_INC(Handler, NoData);
+      return SHT3x_NO_DATA;
+    }
+
+    Handler->MeasurementPending = 0;
+  }
+  else
+  {
+    PlatformResult = SHT3x_SendReceive(Handler, Handler->Command, Buffer, 6);
+    if (PlatformResult == -3)
+    {
+      SHT3X_STATS_INC(Handler, NoData);
+      SHT3x_PeriodicNoData(Handler);
+      return SHT3x_NO_DATA;
+    }
+    else if (PlatformResult != 0)
+      return SHT3x_FAIL;
+
+    SHT3x_PeriodicFetched(Handler);
+  }
+
+  return SHT3x_ParseSample(Handler, Buffer, Sample);
+}
+
+
+/**
+ * @brief  Read a sample using interrupt/DMA driven transfers
+ * @note   The function starts the transfer and returns immediately. Callback
+ *         is called when reading is finished. Sample must stay valid until
+ *         then.
+ * @note   In Single Shot mode, the measurement must be started by
+ *         SHT3x_StartMeasurement() before. If it is not finished yet, the
+ *         function returns SHT3x_NO_DATA and the bus is not accessed.
+ * @note   Conversion of the sample is done in the completion context. Use
+ *         SHT3x_SetConversion() to keep it short.
+ *
+ * @param  Handler: Pointer to handler
+ * @param  Sample: Pointer to sample buffer
+ * @param  Callback: Completion function (optional)
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Reading is started.
+ *         - SHT3x_FAIL: Failed to start the transfer or another asynchronous
+ *                       reading is in progress.
+ *         - SHT3x_INVALID_PARAM: PlatformTransferAsync is not set or no
+ *                                measurement is in progress.
+ *         - SHT3x_NO_DATA: Measurement is still in progress.
+ */
+SHT3x_Result_t
+SHT3x_ReadSampleAsync(SHT3x_Handler_t *Handler, SHT3x_Sample_t *Sample,
+                      SHT3x_AsyncCallback_t Callback)
+{
+  SHT3x_Result_t Result = SHT3x_OK;
+  int8_t PlatformResult = 0;
+
+  if (!Handler->PlatformTransferAsync)
+    return SHT3x_INVALID_PARAM;
+
+  if (Handler->AsyncState != SHT3X_ASYNC_IDLE)
+    return SHT3x_FAIL;
+
+  Handler->AsyncSample = Sample;
+  Handler->AsyncCallback = Callback;
+
+  if (SHT3X_MODE(Handler) == SHT3x_MODE_SINGLESHOT)
+  {
+    Result = SHT3x_IsReady(Handler);
+    if (Result != SHT3x_OK)
+      return Result;
+
+    Handler->AsyncState = SHT3X_ASYNC_RECEIVE;
+    PlatformResult =
+        Handler->PlatformTransferAsync(Handler->Context, Handler->AddressI2C,
+                                       Handler->AsyncBuffer, 6, 1,
+                                       SHT3x_AsyncDone, Handler);
+  }
+  else
+  {
+    Handler->AsyncState = SHT3X_ASYNC_SEND_CMD;
+    PlatformResult =
+        Handler->PlatformTransferAsync(Handler->Context, Handler->AddressI2C,
+                                       Handler->Command, 2, 0,
+                                       SHT3x_AsyncDone, Handler);
+  }
+
+  if (PlatformResult != 0)
+  {
+    Handler->AsyncState = SHT3X_ASYNC_IDLE;
+    return SHT3x_FAIL;
+  }
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Check if an asynchronous reading is in progress
+ * @param  Handler: Pointer to handler
+ * @retval 
+ *         - 0: No asynchronous reading is in progress.
+ *         - 1: Asynchronous reading is in progress.
+ */
+uint8_t
+SHT3x_IsAsyncBusy(SHT3x_Handler_t *Handler)
+{
+  return (Handler->AsyncState != SHT3X_ASYNC_IDLE) ? 1 : 0;
+}
+
+
+/**
+ * @brief  Get the maximum measurement duration in Single Shot mode
+ * @param  Repeatability: Specify repeatability level
+ * @retval Measurement duration in us (0 if Repeatability is not valid)
+ */
+uint32_t
+SHT3x_GetMeasurementTime(SHT3x_Repeatability_t Repeatability)
+{
+  if (Repeatability > SHT3x_REPEATABILITY_HIGH)
+    return 0;
+
+  return SHT3x_MeasurementTime[Repeatability];
+}
+
+
+/**
+ * @brief  Get the time until the next sample is expected to be ready
+ * @note   In Periodic and ART mode, the first sample is expected one
+ *         measurement time after the mode is started and next ones are
+ *         expected on a grid of sample periods. The grid is moved to the last
+ *         successful fetch when a sample arrives earlier or later than
+ *         expected. A late sample is expected again after 1/64 of the sample
+ *         period. In Single Shot mode, it is the time until the pending
+ *         measurement is finished.
+ * @note   The function never accesses the bus. If PlatformGetTime is not set
+ *         or no measurement is expected, it returns 0.
+ *
+ * @param  Handler: Pointer to handler
+ * @retval Time until the next sample in us
+ */
+uint32_t
+SHT3x_NextSampleDueIn(SHT3x_Handler_t *Handler)
+{
+  uint32_t DueTime;
+  int32_t DueIn;
+
+  if (!SHT3X_HAS_GET_TIME(Handler))
+    return 0;
+
+  if (SHT3X_MODE(Handler) == SHT3x_MODE_SINGLESHOT)
+  {
+    if (!Handler->MeasurementPending)
+      return 0;
+    DueTime = Handler->MeasurementDeadline;
+  }
+  else
+  {
+    DueTime = Handler->SampleDue;
+  }
+
+  DueIn = (int32_t)(DueTime - SHT3x_GetTime(Handler));
+
+  return (DueIn > 0) ? (uint32_t)DueIn : 0;
+}
+
+
+/**
+ * @brief  Get the time until the pending Single Shot measurement is expected
+ *         to be finished
+ * @note   If PlatformGetTime is set, it is SHT3x_NextSampleDueIn(). Else the
+ *         elapsed time is unknown and the maximum measurement time of the
+ *         current repeatability is returned.
+ * @note   The function never accesses the bus.
+ *
+ * @param  Handler: Pointer to handler
+ * @retval Time in us (0 if no Single Shot measurement is pending)
+ */
+uint32_t
+SHT3x_MeasurementDueIn(SHT3x_Handler_t *Handler)
+{
+  if (SHT3X_MODE(Handler) != SHT3x_MODE_SINGLESHOT ||
+      !Handler->MeasurementPending)
+    return 0;
+
+  if (SHT3X_HAS_GET_TIME(Handler))
+    return SHT3x_NextSampleDueIn(Handler);
+
+  return SHT3x_GetMeasurementTime(SHT3X_REPEATABILITY(Handler));
+}
+
+
+/**
+ * @brief  Wait until the pending Single Shot measurement is expected to be
+ *         finished
+ * @note   It waits SHT3x_MeasurementDueIn() at once by PlatformDelayUs if it
+ *         is set, else by PlatformDelay (rounded up to ms).
+ *
+ * @param  Handler: Pointer to handler
+ * @retval Waited time in us
+ */
+uint32_t
+SHT3x_WaitMeasurement(SHT3x_Handler_t *Handler)
+{
+  uint32_t Delay = SHT3x_MeasurementDueIn(Handler);
+
+  SHT3x_DelayUs(Handler, Delay);
+
+  return Delay;
+}
+
+
+
+/**
+ ==================================================================================
+               ##### Public Control and Status Functions #####                     
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initializer function
+ * @param  Handler: Pointer to handler
+ * @param  Address: The address depends on ADDR pin state. You should use one of
+ *                  this options:
+ *         - 0: This address used when ADDR is connected VSS
+ *         - 1: This address used when ADDR is connected VDD
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_Init(SHT3x_Handler_t *Handler, uint8_t Address)
+{
+  SHT3x_Result_t Result = SHT3x_OK;
+
+  Result = SHT3x_InitHandler(Handler, Address);
+  if (Result != SHT3x_OK)
+    return Result;
+
+  SHT3x_SetDefaultMode(Handler);
+
+  if (SHT3x_SoftReset(Handler) != SHT3x_OK)
+      return SHT3x_FAIL;
+
+  SHT3x_DelayUs(Handler, SHT3X_SOFT_RESET_TIME);
+  
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Initialize several sensors at once
+ * @note   Stop and reset commands are sent to all sensors first, then the
+ *         function waits once for the reset and checks each sensor by reading
+ *         its status register (the reset bit must be set).
+ * @note   With GeneralCall, one general call reset is sent on each bus (each
+ *         distinct Context) instead of a soft reset per sensor. It resets all
+ *         devices on the bus that support the general call, not only the
+ *         SHT3x sensors. If the general call is not acknowledged, soft reset
+ *         is used for the sensors of that bus.
+ *
+ * @param  Handlers: Pointer to array of handlers (Count items)
+ * @param  Addresses: Pointer to array of addresses (Count items). See
+ *                    SHT3x_Init().
+ * @param  Count: Number of handlers
+ * @param  GeneralCall: 1 to use the I2C general call reset, 0 to use soft
+ *                      reset
+ * @param  Results: Pointer to array of results of each sensor (Count items)
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: All sensors are initialized successfully.
+ *         - SHT3x_FAIL: Initializing of at least one sensor failed.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_InitMany(SHT3x_Handler_t *Handlers, const uint8_t *Addresses,
+               uint8_t Count, uint8_t GeneralCall, SHT3x_Result_t *Results)
+{
+  SHT3x_Handler_t *Handler;
+  SHT3x_Handler_t *Waiting = NULL;
+  SHT3x_Result_t Result = SHT3x_OK;
+  uint16_t Status;
+  uint8_t cmd[1];
+  uint8_t i, j;
+  int8_t Sent;
+
+  if (!Handlers || !Addresses || !Results || !Count)
+    return SHT3x_INVALID_PARAM;
+
+  for (i = 0; i < Count; i++)
+  {
+    Handler = &Handlers[i];
+    Results[i] = SHT3x_InitHandler(Handler, Addresses[i]);
+    if (Results[i] == SHT3x_OK)
+      Results[i] = SHT3x_SetDefaultMode(Handler);
+  }
+
+  for (i = 0; i < Count; i++)
+  {
+    Handler = &Handlers[i];
+    if (Results[i] != SHT3x_OK)
+      continue;
+
+    if (GeneralCall)
+    {
+      // One general call for each bus
+      for (j = 0; j < i; j++)
+      {
+        if (SHT3x_SameBus(&Handlers[j], Handler))
+          break;
+      }
+      if (j < i)
+        continue;
+
+      cmd[0] = SHT3X_COMMAND_GENERAL_CALL_RESET;
+      Sent = -1;
+      if (SHT3x_Lock(Handler) == 0)
+      {
+        Sent = SHT3x_CountTransfer(Handler, 1,
+            SHT3X_CALL_SEND(Handler, SHT3X_I2C_ADDRESS_GENERAL_CALL, cmd, 1));
+        SHT3x_Unlock(Handler);
+      }
+      if (Sent == 0)
+      {
+        Waiting = Handler;
+        continue;
+      }
+
+      // Not acknowledged, reset the sensors of this bus one by one
+      for (j = i; j < Count; j++)
+      {
+        if (Results[j] == SHT3x_OK && SHT3x_SameBus(&Handlers[j], Handler))
+          Results[j] = SHT3x_SoftReset(&Handlers[j]);
+        if (Results[j] == SHT3x_OK)
+          Waiting = &Handlers[j];
+      }
+      continue;
+    }
+
+    Results[i] = SHT3x_SoftReset(Handler);
+    if (Results[i] == SHT3x_OK)
+      Waiting = Handler;
+  }
+
+  if (Waiting)
+    SHT3x_DelayUs(Waiting, SHT3X_SOFT_RESET_TIME);
+
+  for (i = 0; i < Count; i++)
+  {
+    if (Results[i] == SHT3x_OK)
+    {
+      Results[i] = SHT3x_ReadStatus(&Handlers[i], &Status);
+      if (Results[i] == SHT3x_OK && !(Status & SHT3x_STATUS_RESET_DETECTED))
+        Results[i] = SHT3x_FAIL;
+    }
+
+    if (Results[i] != SHT3x_OK)
+      Result = SHT3x_FAIL;
+  }
+
+  return Result;
+}
+
+
+/**
+ * @brief  Find the sensors on the buses
+ * @note   Both addresses are checked on each bus by PlatformProbe (if it is
+ *         set) and a status register read. A handler is filled for each
+ *         sensor found: it is a copy of the bus handler with the address of
+ *         the sensor, initialized in Single Shot mode without reset. Use
+ *         SHT3x_DeInit() to release it.
+ * @note   Each filled handler holds one PlatformInit call and the other
+ *         calls (at most one per bus at a time) are released by
+ *         PlatformDeInit before returning. If several sensors share a bus,
+ *         the port must count PlatformInit and PlatformDeInit calls and
+ *         release the bus on the last one.
+ *
+ * @param  Buses: Pointer to array of bus handlers (BusCount items). Only
+ *                platform functions and Context are used.
+ * @param  BusCount: Number of buses
+ * @param  Handlers: Pointer to array of handlers to fill (MaxHandlers items)
+ * @param  MaxHandlers: Maximum number of handlers
+ * @param  Found: Pointer to number of sensors found
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: All buses are checked.
+ *         - SHT3x_FAIL: Initializing of at least one bus failed or a sensor
+ *                       was found when Handlers was full.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_Discover(const SHT3x_Handler_t *Buses, uint8_t BusCount,
+               SHT3x_Handler_t *Handlers, uint8_t MaxHandlers, uint8_t *Found)
+{
+  static const uint8_t Address[2] = {SHT3X_I2C_ADDRESS_A, SHT3X_I2C_ADDRESS_B};
+  SHT3x_Handler_t Candidate;
+  SHT3x_Result_t Result = SHT3x_OK;
+  uint16_t Status;
+  uint8_t Count = 0;
+  uint8_t Initialized;  // Candidate holds a PlatformInit call
+  uint8_t i, j;
+
+  if (!Buses || !BusCount || !Handlers || !Found)
+    return SHT3x_INVALID_PARAM;
+
+  for (i = 0; i < BusCount; i++)
+  {
+    Initialized = 0;
+
+    for (j = 0; j < 2; j++)
+    {
+      // Probe into a scratch handler, so a miss needs no free slot
+      Candidate = Buses[i];
+      if (SHT3x_PrepareHandler(&Candidate, Address[j]) != SHT3x_OK)
+      {
+        Result = SHT3x_FAIL;
+        break;
+      }
+
+      if (!Initialized)
+      {
+        if (SHT3X_HAS_INIT(&Candidate) && SHT3X_CALL_INIT(&Candidate) != 0)
+        {
+          Result = SHT3x_FAIL;
+          break;
+        }
+        Initialized = 1;
+      }
+
+      if ((SHT3X_HAS_PROBE(&Candidate) &&
+           SHT3x_CountTransfer(&Candidate, 0,
+               SHT3X_CALL_PROBE(&Candidate, Address[j])) != 0) ||
+          SHT3x_ReadStatus(&Candidate, &Status) != SHT3x_OK ||
+          SHT3x_SetDefaultMode(&Candidate) != SHT3x_OK)
+        continue;
+
+      if (Count >= MaxHandlers)
+      {
+        Result = SHT3x_FAIL;
+        break;
+      }
+
+      // The new handler takes the PlatformInit call of Candidate
+      Candidate.MeasurementPending = 0;
+      Handlers[Count++] = Candidate;
+      Initialized = 0;
+    }
+
+    if (Initialized)
+      SHT3x_DeInit(&Candidate);
+  }
+
+  *Found = Count;
+  return Result;
+}
+
+/**
+ * @brief  Deinitialize function
+ * @param  Handler: Pointer to handler
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
  *         - SHT3x_FAIL: Failed to send or receive data.
  */
 SHT3x_Result_t
 SHT3x_DeInit(SHT3x_Handler_t *Handler)
 {
-  if (Handler->PlatformDeInit)
+  if (SHT3X_HAS_DEINIT(Handler))
   {
-    if (Handler->PlatformDeInit() != 0)
+    if (SHT3X_CALL_DEINIT(Handler) != 0)
       return SHT3x_FAIL;
   }
   return SHT3x_OK;
@@ -477,9 +1943,13 @@ SHT3x_DeInit(SHT3x_Handler_t *Handler)
  *                  this options:
  *         - 0: This address used when ADDR is connected VSS
  *         - 1: This address used when ADDR is connected VDD
+ *         The 7-bit (0x44, 0x45) and 8-bit (0x88, 0x8A) addresses are also
+ *         accepted.
  * 
  * @retval SHT3x_Result_t
  *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: Address is not valid (address is not
+ *                                changed).
  */
 SHT3x_Result_t
 SHT3x_SetAddressI2C(SHT3x_Handler_t *Handler, uint8_t Address)
@@ -492,6 +1962,8 @@ SHT3x_SetAddressI2C(SHT3x_Handler_t *Handler, uint8_t Address)
            Address == SHT3X_I2C_ADDRESS_B ||
            Address == (SHT3X_I2C_ADDRESS_B << 1))
     Handler->AddressI2C = SHT3X_I2C_ADDRESS_B;
+  else
+    return SHT3x_INVALID_PARAM;
 
   return SHT3x_OK;
 }
@@ -514,15 +1986,16 @@ SHT3x_ReadStatus(SHT3x_Handler_t *Handler, uint16_t *Status)
 
   cmd[0] = SHT3X_COMMAND_STATUS_READ_MSB;
   cmd[1] = SHT3X_COMMAND_STATUS_READ_LSB;
-  if (Handler->PlatformSend(Handler->AddressI2C, cmd, 2) != 0)
+  if (SHT3x_SendReceive(Handler, cmd, Buffer, 3) != 0)
     return SHT3x_FAIL;
 
-  if (Handler->PlatformReceive(Handler->AddressI2C, Buffer, 3) != 0)
-    return SHT3x_FAIL;
+  if (SHT3x_CheckCRC(Handler, Buffer, 1) != SHT3x_OK)
+    return SHT3x_CRC_ERROR;
 
   *Status = (Buffer[0]<<8) | Buffer[1];
-  if (Handler->PlatformCRC(*Status, Buffer[2]) != 0)
-    return SHT3x_CRC_ERROR;
+  Handler->Status = *Status;
+  Handler->StatusValid = 1;
+  Handler->StatusSamples = 0;
 
   return SHT3x_OK;
 }
@@ -542,8 +2015,10 @@ SHT3x_ClearStatus(SHT3x_Handler_t *Handler)
 
   cmd[0] = SHT3X_COMMAND_STATUS_CLEAR_MSB;
   cmd[1] = SHT3X_COMMAND_STATUS_CLEAR_LSB;
-  if (Handler->PlatformSend(Handler->AddressI2C, cmd, 2) != 0)
+  if (SHT3x_Send(Handler, cmd, 2) != 0)
     return SHT3x_FAIL;
+  Handler->Status &= ~(SHT3x_STATUS_ALERT_PENDING | SHT3x_STATUS_RH_ALERT |
+                       SHT3x_STATUS_T_ALERT | SHT3x_STATUS_RESET_DETECTED);
   
   return SHT3x_OK;
 }
@@ -576,8 +2051,460 @@ SHT3x_SetHeater(SHT3x_Handler_t *Handler, uint8_t Heater)
     cmd[1] = SHT3X_COMMAND_HEATER_DISABLE_LSB;
   }
 
-  if (Handler->PlatformSend(Handler->AddressI2C, cmd, 2) != 0)
+  if (SHT3x_Send(Handler, cmd, 2) != 0)
     return SHT3x_FAIL;
+
+  if (Heater)
+    Handler->Status |= SHT3x_STATUS_HEATER_ON;
+  else
+    Handler->Status &= ~SHT3x_STATUS_HEATER_ON;
   
   return SHT3x_OK;
 }
+
+
+/**
+ * @brief  Get the status register with the cache policy
+ * @note   The last status word is cached in the handler. SHT3x_ReadStatus(),
+ *         SHT3x_ClearStatus() and SHT3x_SetHeater() keep the cache up to
+ *         date. The status register is read from the bus only if the cache is
+ *         not valid: after SHT3x_Init(), after a bus or CRC error, or after
+ *         the number of samples set by SHT3x_SetStatusRefresh().
+ *
+ * @param  Handler: Pointer to handler
+ * @param  Status: pointer to status register 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ */
+SHT3x_Result_t
+SHT3x_GetStatus(SHT3x_Handler_t *Handler, uint16_t *Status)
+{
+  if (!Handler->StatusValid)
+    return SHT3x_ReadStatus(Handler, Status);
+
+  *Status = Handler->Status;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Check a flag of the status register with the cache policy
+ * @note   See SHT3x_GetStatus().
+ * @param  Handler: Pointer to handler
+ * @param  Flag: One of SHT3x_StatusFlag_t
+ * @param  Set: Pointer to result (1 if the flag is set, 0 otherwise)
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ */
+SHT3x_Result_t
+SHT3x_GetStatusFlag(SHT3x_Handler_t *Handler, SHT3x_StatusFlag_t Flag,
+                    uint8_t *Set)
+{
+  uint16_t Status = 0;
+  SHT3x_Result_t Result = SHT3x_GetStatus(Handler, &Status);
+
+  if (Result != SHT3x_OK)
+    return Result;
+
+  *Set = (Status & Flag) ? 1 : 0;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Set the refresh policy of the cached status register
+ * @param  Handler: Pointer to handler
+ * @param  Every: The cache is invalidated after this number of samples
+ *                (0: only on error)
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ */
+SHT3x_Result_t
+SHT3x_SetStatusRefresh(SHT3x_Handler_t *Handler, uint16_t Every)
+{
+  Handler->StatusRefreshEvery = Every;
+  Handler->StatusSamples = 0;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Write an alert limit
+ * @note   The ALERT pin and the alert bits of the status register are
+ *         driven in Periodic and ART mode. The limit is stored with the
+ *         resolution of the sensor format (7 MSBs of RH and 9 MSBs of T).
+ *
+ * @param  Handler: Pointer to handler
+ * @param  Limit: Specify the alert limit
+ * @param  TempCentiCelsius: Temperature limit in 0.01 C (-4500 to 13000)
+ * @param  HumCentiPercent: Relative humidity limit in 0.01 % (0 to 10000)
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_WriteAlertLimit(SHT3x_Handler_t *Handler, SHT3x_AlertLimit_t Limit,
+                      int16_t TempCentiCelsius, uint16_t HumCentiPercent)
+{
+  uint8_t Buffer[5];
+  uint16_t TempRaw;
+  uint16_t HumRaw;
+  uint16_t Word;
+
+  if (Limit > SHT3x_ALERT_LOW_SET ||
+      TempCentiCelsius < -4500 || TempCentiCelsius > 13000 ||
+      HumCentiPercent > 10000)
+    return SHT3x_INVALID_PARAM;
+
+  TempRaw = (uint16_t)(((uint32_t)(TempCentiCelsius + 4500) * 65535) / 17500);
+  HumRaw = (uint16_t)(((uint32_t)HumCentiPercent * 65535) / 10000);
+
+  // RH[15:9] in bits 15..9 and T[15:7] in bits 8..0
+  Word = (HumRaw & 0xFE00) | (TempRaw >> 7);
+
+  Buffer[0] = SHT3X_COMMAND_ALERT_WRITE_MSB;
+  Buffer[1] = SHT3X_READ_CONST_BYTE(SHT3x_CommandAlert[Limit][1]);
+  Buffer[2] = Word >> 8;
+  Buffer[3] = Word & 0xFF;
+  Buffer[4] = SHT3x_CalcCRC(&Buffer[2], 2);
+  if (SHT3x_Send(Handler, Buffer, 5) != 0)
+    return SHT3x_FAIL;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Read back an alert limit
+ * @param  Handler: Pointer to handler
+ * @param  Limit: Specify the alert limit
+ * @param  TempCentiCelsius: Pointer to temperature limit in 0.01 C
+ * @param  HumCentiPercent: Pointer to relative humidity limit in 0.01 %
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_ReadAlertLimit(SHT3x_Handler_t *Handler, SHT3x_AlertLimit_t Limit,
+                     int16_t *TempCentiCelsius, uint16_t *HumCentiPercent)
+{
+  uint8_t cmd[2];
+  uint8_t Buffer[3];
+  uint16_t Word;
+
+  if (Limit > SHT3x_ALERT_LOW_SET)
+    return SHT3x_INVALID_PARAM;
+
+  cmd[0] = SHT3X_COMMAND_ALERT_READ_MSB;
+  cmd[1] = SHT3X_READ_CONST_BYTE(SHT3x_CommandAlert[Limit][0]);
+  if (SHT3x_SendReceive(Handler, cmd, Buffer, 3) != 0)
+    return SHT3x_FAIL;
+
+  if (SHT3x_CheckCRC(Handler, Buffer, 1) != SHT3x_OK)
+    return SHT3x_CRC_ERROR;
+
+  Word = (Buffer[0] << 8) | Buffer[1];
+  *TempCentiCelsius =
+      (int16_t)((((uint32_t)(Word & 0x01FF) << 7) * 17500) / 65535) - 4500;
+  *HumCentiPercent =
+      (uint16_t)(((uint32_t)(Word & 0xFE00) * 10000) / 65535);
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Set the failure policy (bus recovery and circuit breaker)
+ * @note   After FailLimit consecutive failed transfers, PlatformBusRecovery is
+ *         called (if it is set) and the circuit breaker is opened: transfers
+ *         of this handler fail at once without accessing the bus for the
+ *         backoff time. Then transfers are allowed again. A failure at this
+ *         point opens the breaker again with twice the backoff (up to
+ *         BackoffMax). A successful transfer closes the breaker and resets
+ *         the backoff to BackoffMin.
+ * @note   A NACK of a read header is not a failure, because the sensor does
+ *         it while it is measuring. SHT3x_ReadSampleAsync() transfers are not
+ *         covered.
+ * @note   The breaker needs PlatformGetTime. Without it, only the bus
+ *         recovery is done.
+ *
+ * @param  Handler: Pointer to handler
+ * @param  FailLimit: Number of consecutive failures (0: disable)
+ * @param  BackoffMin: First backoff time in ms (0: no breaker)
+ * @param  BackoffMax: Maximum backoff time in ms
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_SetFailPolicy(SHT3x_Handler_t *Handler, uint8_t FailLimit,
+                    uint32_t BackoffMin, uint32_t BackoffMax)
+{
+  if (BackoffMax < BackoffMin || BackoffMax > 2000000)
+    return SHT3x_INVALID_PARAM;
+
+  Handler->FailLimit = FailLimit;
+  Handler->BackoffMin = BackoffMin;
+  Handler->BackoffMax = BackoffMax;
+  Handler->Backoff = BackoffMin;
+  Handler->FailCount = 0;
+  Handler->BreakerOpen = 0;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Check if the circuit breaker of the handler is open
+ * @param  Handler: Pointer to handler
+ * @retval 1 if transfers are rejected now, 0 otherwise
+ */
+uint8_t
+SHT3x_IsBreakerOpen(SHT3x_Handler_t *Handler)
+{
+  if (!Handler->BreakerOpen)
+    return 0;
+
+  return ((int32_t)(SHT3x_GetTime(Handler) - Handler->BreakerRetry) < 0) ?
+         1 : 0;
+}
+
+
+/**
+ * @brief  Recover the bus of the handler and close its circuit breaker
+ * @param  Handler: Pointer to handler
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to recover the bus.
+ *         - SHT3x_INVALID_PARAM: PlatformBusRecovery is not set.
+ */
+SHT3x_Result_t
+SHT3x_RecoverBus(SHT3x_Handler_t *Handler)
+{
+  SHT3x_Result_t Result = SHT3x_OK;
+
+  if (!SHT3X_HAS_BUS_RECOVERY(Handler))
+    return SHT3x_INVALID_PARAM;
+
+  if (SHT3x_Lock(Handler) != 0)
+    return SHT3x_FAIL;
+
+  Handler->FailCount = 0;
+  Handler->BreakerOpen = 0;
+  Handler->Backoff = Handler->BackoffMin;
+  Handler->StatusValid = 0;
+  SHT3X_STATS_INC(Handler, Recoveries);
+  if (SHT3X_CALL_BUS_RECOVERY(Handler) != 0)
+    Result = SHT3x_FAIL;
+
+  SHT3x_Unlock(Handler);
+  return Result;
+}
+
+
+/**
+ * @brief  Tell the driver that the caller holds the bus lock
+ * @note   While it is set, the driver does not call PlatformLock and
+ *         PlatformUnlock of the handler. So the caller can run several
+ *         functions, or functions of several handlers on the same bus, under
+ *         one lock hold. Do not change it while a function of the handler is
+ *         running.
+ *
+ * @param  Handler: Pointer to handler
+ * @param  Held:
+ *         - 0: The caller does not hold the lock
+ *         - 1: The caller holds the lock
+ * 
+ * @retval None
+ */
+void
+SHT3x_SetLockHeld(SHT3x_Handler_t *Handler, uint8_t Held)
+{
+  Handler->LockHeld = Held ? 1 : 0;
+}
+
+
+
+#if (SHT3X_CONFIG_STATS == 1)
+/**
+ ==================================================================================
+                      ##### Public Statistics Functions #####                      
+ ==================================================================================
+ */
+
+/**
+ * @brief  Take a snapshot of the performance counters
+ * @note   Counters updated from interrupt context (asynchronous reading) may
+ *         be out of date by one update.
+ *
+ * @param  Handler: Pointer to handler
+ * @param  Stats: Pointer to the snapshot
+ * @retval None
+ */
+void
+SHT3x_GetStats(SHT3x_Handler_t *Handler, SHT3x_Stats_t *Stats)
+{
+  *Stats = Handler->Stats;
+  Stats->LatencyAvg = Stats->Reads ?
+                      (uint32_t)(Stats->LatencyTotal / Stats->Reads) : 0;
+}
+
+
+/**
+ * @brief  Reset the performance counters
+ * @param  Handler: Pointer to handler
+ * @retval None
+ */
+void
+SHT3x_ResetStats(SHT3x_Handler_t *Handler)
+{
+  SHT3x_Stats_t Empty = {0};
+
+  Handler->Stats = Empty;
+}
+#endif
+
+
+
+/**
+ ==================================================================================
+                       ##### Public Utility Functions #####                        
+ ==================================================================================
+ */
+
+/**
+ * @brief  Convert raw values of a sample
+ * @note   Only conversions included in SHT3X_CONFIG_CONVERSION are done.
+ * @param  Sample: Pointer to sample. TempRaw and HumRaw must be valid.
+ * @param  Conversion: Combination of SHT3x_Conversion_t flags
+ * @retval None
+ */
+void
+SHT3x_ConvertSample(SHT3x_Sample_t *Sample, uint8_t Conversion)
+{
+#if (SHT3X_CONFIG_FLOAT == 1) && (SHT3X_CONFIG_CONVERSION & 0x03)
+  float TempBuff = Sample->TempRaw / 65535.0f;
+#endif
+
+  // In fixed-point conversions, division by 65535 is replaced by a rounded
+  // shift (error < 0.01 units)
+  (void)Sample;
+  Conversion &= SHT3X_CONFIG_CONVERSION;
+
+#if (SHT3X_CONFIG_CONVERSION & 0x01) // Celsius
+  if (Conversion & SHT3x_CONVERSION_CELSIUS)
+  {
+#if (SHT3X_CONFIG_FLOAT == 1)
+    Sample->TempCelsius = (TempBuff * 175) - 45;
+#endif
+#if (SHT3X_CONFIG_FIXED_POINT == 1)
+    Sample->TempCentiCelsius =
+        (int16_t)((int32_t)(((uint32_t)Sample->TempRaw * 17500UL + 32768UL) >> 16) - 4500);
+#endif
+  }
+#endif
+
+#if (SHT3X_CONFIG_CONVERSION & 0x02) // Fahrenheit
+  if (Conversion & SHT3x_CONVERSION_FAHRENHEIT)
+  {
+#if (SHT3X_CONFIG_FLOAT == 1)
+    Sample->TempFahrenheit = (TempBuff * 315) - 49;
+#endif
+#if (SHT3X_CONFIG_FIXED_POINT == 1)
+    Sample->TempCentiFahrenheit =
+        (int16_t)((int32_t)(((uint32_t)Sample->TempRaw * 31500UL + 32768UL) >> 16) - 4900);
+#endif
+  }
+#endif
+
+#if (SHT3X_CONFIG_CONVERSION & 0x04) // Humidity
+  if (Conversion & SHT3x_CONVERSION_HUMIDITY)
+  {
+#if (SHT3X_CONFIG_FLOAT == 1)
+    Sample->HumidityPercent = (Sample->HumRaw / 65535.0f) * 100;
+#endif
+#if (SHT3X_CONFIG_FIXED_POINT == 1)
+    Sample->HumCentiPercent =
+        (uint16_t)(((uint32_t)Sample->HumRaw * 10000UL + 32768UL) >> 16);
+#endif
+  }
+#endif
+}
+
+
+#if (SHT3X_CONFIG_FLOAT == 1)
+/**
+ * @brief  Convert an array of raw values (structure of arrays layout)
+ * @note   The loop is written so compilers can vectorize it. Raw and Out
+ *         must not overlap.
+ * @param  Raw: Pointer to array of raw values (TempRaw or HumRaw)
+ * @param  Out: Pointer to output array
+ * @param  Len: Number of items
+ * @param  Conversion: One of these flags:
+ *         - SHT3x_CONVERSION_CELSIUS: Raw contains TempRaw values
+ *         - SHT3x_CONVERSION_FAHRENHEIT: Raw contains TempRaw values
+ *         - SHT3x_CONVERSION_HUMIDITY: Raw contains HumRaw values
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_ConvertBatch(const uint16_t *Raw, float *Out, size_t Len,
+                   SHT3x_Conversion_t Conversion)
+{
+  switch (Conversion)
+  {
+  case SHT3x_CONVERSION_CELSIUS:
+    SHT3x_ConvertBatchKernel(Raw, Out, Len, 175.0f / 65535.0f, -45.0f);
+    break;
+
+  case SHT3x_CONVERSION_FAHRENHEIT:
+    SHT3x_ConvertBatchKernel(Raw, Out, Len, 315.0f / 65535.0f, -49.0f);
+    break;
+
+  case SHT3x_CONVERSION_HUMIDITY:
+    SHT3x_ConvertBatchKernel(Raw, Out, Len, 100.0f / 65535.0f, 0.0f);
+    break;
+
+  default:
+    return SHT3x_INVALID_PARAM;
+    break;
+  }
+
+  return SHT3x_OK;
+}
+#endif
+
+
+/**
+ * @brief  Calculate CRC-8 of data the same way the sensor does
+ *         (Polynomial: 0x31, Initialization: 0xFF)
+ * @param  Data: Pointer to data
+ * @param  Len: data len in Bytes
+ * @retval CRC of data
+ */
+uint8_t
+SHT3x_CalcCRC(const uint8_t *Data, uint8_t Len)
+{
+  uint8_t CRC = SHT3X_CRC_INIT;
+
+  for (; Len > 0; Len--)
+    CRC = SHT3x_UpdateCRC(CRC, *Data++);
+
+  return CRC;
+}
@@ -0,0 +1,282 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_bus.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Shared bus manager for several SHT3x handlers
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "SHT3x_bus.h"
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static void
+SHT3x_BusEnter(SHT3x_Bus_t *Bus)
+{
+  if (Bus->Enter)
+    Bus->Enter(Bus->Context);
+}
+
+
+static void
+SHT3x_BusExit(SHT3x_Bus_t *Bus)
+{
+  if (Bus->Exit)
+    Bus->Exit(Bus->Context);
+}
+
+
+static SHT3x_Result_t
+SHT3x_BusRun(SHT3x_BusRequest_t *Request)
+{
+  switch (Request->Operation)
+  {
+  case SHT3x_BUS_READ_SAMPLE:
+    return SHT3x_ReadSample(Request->Handler, (SHT3x_Sample_t *)Request->Data);
+
+  case SHT3x_BUS_FETCH_SAMPLE:
+    return SHT3x_FetchSample(Request->Handler, (SHT3x_Sample_t *)Request->Data);
+
+  case SHT3x_BUS_START_MEASUREMENT:
+    return SHT3x_StartMeasurement(Request->Handler);
+
+  case SHT3x_BUS_READ_STATUS:
+    return SHT3x_ReadStatus(Request->Handler, (uint16_t *)Request->Data);
+
+  default:
+    return SHT3x_INVALID_PARAM;
+  }
+}
+
+
+/**
+ * @brief  Remove a request from the queue if it is still there
+ * @retval 1: The request is removed, 0: The request is not queued (it is done
+ *         or another task runs it)
+ */
+static uint8_t
+SHT3x_BusCancel(SHT3x_Bus_t *Bus, SHT3x_BusRequest_t *Request)
+{
+  SHT3x_BusRequest_t *Previous = NULL;
+  SHT3x_BusRequest_t *Item;
+  uint8_t Removed = 0;
+
+  SHT3x_BusEnter(Bus);
+  for (Item = Bus->Head; Item; Previous = Item, Item = Item->Next)
+  {
+    if (Item != Request)
+      continue;
+
+    if (Previous)
+      Previous->Next = Item->Next;
+    else
+      Bus->Head = Item->Next;
+    if (Bus->Tail == Item)
+      Bus->Tail = Previous;
+    Item->Next = NULL;
+    Removed = 1;
+    break;
+  }
+  SHT3x_BusExit(Bus);
+
+  return Removed;
+}
+
+
+
+/**
+ ==================================================================================
+                             ##### Bus Functions #####                             
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the shared bus
+ * @note   Set Context, Lock, Unlock, Enter and Exit before calling this
+ *         function.
+ *
+ * @param  Bus: Pointer to bus
+ * 
+ * @retval None
+ */
+void
+SHT3x_BusInit(SHT3x_Bus_t *Bus)
+{
+  Bus->Head = NULL;
+  Bus->Tail = NULL;
+}
+
+
+/**
+ * @brief  Add a request to the queue of the bus
+ * @note   Handler, Operation and Data of the request must be set. The request
+ *         runs on the next call of SHT3x_BusProcess().
+ * @note   It can be called from any task or interrupt if Enter and Exit are
+ *         set.
+ *
+ * @param  Bus: Pointer to bus
+ * @param  Request: Pointer to request
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_BusSubmit(SHT3x_Bus_t *Bus, SHT3x_BusRequest_t *Request)
+{
+  if (!Bus || !Request || !Request->Handler)
+    return SHT3x_INVALID_PARAM;
+
+  if (Request->Operation > SHT3x_BUS_READ_STATUS)
+    return SHT3x_INVALID_PARAM;
+
+  if (!Request->Data && Request->Operation != SHT3x_BUS_START_MEASUREMENT)
+    return SHT3x_INVALID_PARAM;
+
+  Request->Done = 0;
+  Request->Next = NULL;
+
+  SHT3x_BusEnter(Bus);
+  if (Bus->Tail)
+    Bus->Tail->Next = Request;
+  else
+    Bus->Head = Request;
+  Bus->Tail = Request;
+  SHT3x_BusExit(Bus);
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Run all queued requests back-to-back under one bus lock hold
+ * @note   While a request runs, the lock of its handler is marked as held (see
+ *         SHT3x_SetLockHeld()), so the driver does not take it again.
+ * @note   Requests submitted while the queue runs are left for the next call.
+ *
+ * @param  Bus: Pointer to bus
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: The queued requests are done (see Result of each one).
+ *         - SHT3x_NO_DATA: The queue is empty.
+ *         - SHT3x_FAIL: Failed to take the bus lock. Queue is not changed.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_BusProcess(SHT3x_Bus_t *Bus)
+{
+  SHT3x_BusRequest_t *Request;
+  SHT3x_BusRequest_t *Next;
+
+  if (!Bus)
+    return SHT3x_INVALID_PARAM;
+
+  if (Bus->Lock && Bus->Lock(Bus->Context) != 0)
+    return SHT3x_FAIL;
+
+  SHT3x_BusEnter(Bus);
+  Request = Bus->Head;
+  Bus->Head = NULL;
+  Bus->Tail = NULL;
+  SHT3x_BusExit(Bus);
+
+  if (!Request)
+  {
+    if (Bus->Unlock)
+      Bus->Unlock(Bus->Context);
+    return SHT3x_NO_DATA;
+  }
+
+  while (Request)
+  {
+    // The owner may reuse the request as soon as Done is set
+    Next = Request->Next;
+    Request->Next = NULL;
+
+    SHT3x_SetLockHeld(Request->Handler, 1);
+    Request->Result = SHT3x_BusRun(Request);
+    SHT3x_SetLockHeld(Request->Handler, 0);
+
+    if (Request->Callback)
+      Request->Callback(Request);
+    Request->Done = 1;
+
+    Request = Next;
+  }
+
+  if (Bus->Unlock)
+    Bus->Unlock(Bus->Context);
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Submit a request and process the queue of the bus
+ * @note   Requests of other handlers in the queue run in the same lock hold.
+ * @note   Lock of the bus must be set if more than one task calls this
+ *         function. If another task has already taken the request from the
+ *         queue, this function waits until it is done and never returns
+ *         while the request is in use.
+ *
+ * @param  Bus: Pointer to bus
+ * @param  Request: Pointer to request
+ * 
+ * @retval SHT3x_Result_t
+ *         - Result of the request if it is done.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ *         - SHT3x_FAIL: Failed to take the bus lock before any task took the
+ *           request. The request is removed from the queue.
+ */
+SHT3x_Result_t
+SHT3x_BusTransfer(SHT3x_Bus_t *Bus, SHT3x_BusRequest_t *Request)
+{
+  SHT3x_Result_t Result;
+
+  Result = SHT3x_BusSubmit(Bus, Request);
+  if (Result != SHT3x_OK)
+    return Result;
+
+  // Another task may have taken the request from the queue. It is done when
+  // that task releases the lock, so wait for it through the lock.
+  Result = SHT3x_BusProcess(Bus);
+  while (!Request->Done)
+  {
+    if (Result == SHT3x_FAIL && SHT3x_BusCancel(Bus, Request))
+      return SHT3x_FAIL;
+
+    Result = SHT3x_BusProcess(Bus);
+  }
+
+  return Request->Result;
+}
@@ -0,0 +1,298 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_heater.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Heater controller for condensation recovery of SHT3x sensor
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "SHT3x_heater.h"
+
+
+/* Private Constants ------------------------------------------------------------*/
+/**
+ * @brief  Times in ms must be less than this value to fit in us
+ */
+#define SHT3X_HEATER_MAX_TIME 2147483
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static uint32_t
+SHT3x_HeaterGetTime(SHT3x_Heater_t *Heater)
+{
+  return Heater->Handler->PlatformGetTime(Heater->Handler->Context);
+}
+
+
+static uint8_t
+SHT3x_HeaterElapsed(uint32_t Now, uint32_t Time)
+{
+  return ((int32_t)(Now - Time) >= 0) ? 1 : 0;
+}
+
+
+/**
+ * @brief  Switch the heater and check the heater bit of the status register
+ */
+static SHT3x_Result_t
+SHT3x_HeaterSwitch(SHT3x_Heater_t *Heater, uint8_t On)
+{
+  uint16_t Status = 0;
+
+  if (SHT3x_SetHeater(Heater->Handler, On) != SHT3x_OK)
+    return SHT3x_FAIL;
+
+  if (SHT3x_ReadStatus(Heater->Handler, &Status) != SHT3x_OK)
+    return SHT3x_FAIL;
+
+  if (((Status & SHT3x_STATUS_HEATER_ON) ? 1 : 0) != On)
+    return SHT3x_FAIL;
+
+  return SHT3x_OK;
+}
+
+
+static SHT3x_Result_t
+SHT3x_HeaterEndRecovery(SHT3x_Heater_t *Heater, uint32_t Now)
+{
+  if (Heater->State == SHT3x_HEATER_ON)
+  {
+    Heater->HeaterOffTime = Now;
+    Heater->Settling = 1;
+  }
+  Heater->State = SHT3x_HEATER_IDLE;
+
+  return SHT3x_HeaterSwitch(Heater, 0);
+}
+
+
+/**
+ * @brief  Switch the heater on the duty cycle
+ */
+static SHT3x_Result_t
+SHT3x_HeaterDutyCycle(SHT3x_Heater_t *Heater, uint32_t Now)
+{
+  if (Heater->State == SHT3x_HEATER_IDLE)
+    return SHT3x_OK;
+
+  if (Heater->Config.MaxRecoveryTime &&
+      SHT3x_HeaterElapsed(Now, Heater->RecoveryStart +
+                               Heater->Config.MaxRecoveryTime * 1000))
+  {
+    Heater->Timeouts++;
+    return SHT3x_HeaterEndRecovery(Heater, Now);
+  }
+
+  if (!SHT3x_HeaterElapsed(Now, Heater->PhaseEnd))
+    return SHT3x_OK;
+
+  if (Heater->State == SHT3x_HEATER_ON)
+  {
+    Heater->State = SHT3x_HEATER_OFF;
+    Heater->PhaseEnd = Now + Heater->Config.OffTime * 1000;
+    Heater->HeaterOffTime = Now;
+    Heater->Settling = 1;
+    return SHT3x_HeaterSwitch(Heater, 0);
+  }
+
+  Heater->State = SHT3x_HEATER_ON;
+  Heater->PhaseEnd = Now + Heater->Config.OnTime * 1000;
+  return SHT3x_HeaterSwitch(Heater, 1);
+}
+
+
+static uint16_t
+SHT3x_HeaterHumidity(const SHT3x_Sample_t *Sample)
+{
+  return (uint16_t)(((uint32_t)Sample->HumRaw * 10000) / 65535);
+}
+
+
+
+/**
+ ==================================================================================
+                          ##### Heater Functions #####                             
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the heater controller and turn the heater off
+ * @note   Handler must be initialized and PlatformGetTime must be set. The
+ *         measurement mode of the handler is not changed.
+ * @note   OffTime must be longer than SettleTime and all times must be less
+ *         than 2147483ms.
+ *
+ * @param  Heater: Pointer to heater controller
+ * @param  Handler: Pointer to handler
+ * @param  Config: Pointer to configuration (copied)
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to turn the heater off.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_HeaterInit(SHT3x_Heater_t *Heater, SHT3x_Handler_t *Handler,
+                 const SHT3x_HeaterConfig_t *Config)
+{
+  if (!Handler->PlatformGetTime || !Config ||
+      Config->HumidityOff > Config->HumidityOn ||
+      !Config->OnTime || !Config->OffTime ||
+      !Config->Interval || !Config->RecoveryInterval)
+    return SHT3x_INVALID_PARAM;
+
+  // Samples of the whole off time would be biased and recovery never ends
+  if (Config->OffTime <= Config->SettleTime)
+    return SHT3x_INVALID_PARAM;
+
+  if (Config->OnTime >= SHT3X_HEATER_MAX_TIME ||
+      Config->OffTime >= SHT3X_HEATER_MAX_TIME ||
+      Config->SettleTime >= SHT3X_HEATER_MAX_TIME ||
+      Config->MaxRecoveryTime >= SHT3X_HEATER_MAX_TIME ||
+      Config->Interval >= SHT3X_HEATER_MAX_TIME ||
+      Config->RecoveryInterval >= SHT3X_HEATER_MAX_TIME)
+    return SHT3x_INVALID_PARAM;
+
+  Heater->Handler = Handler;
+  Heater->Config = *Config;
+  Heater->Timeouts = 0;
+  Heater->State = SHT3x_HEATER_IDLE;
+  Heater->Settling = 0;
+  Heater->NextSample = SHT3x_HeaterGetTime(Heater);
+
+  return SHT3x_HeaterSwitch(Heater, 0);
+}
+
+
+/**
+ * @brief  Run the heater controller
+ * @note   Call this function frequently (e.g. in main loop). It switches the
+ *         heater on its duty cycle and reads a sample when the current
+ *         interval is elapsed. It never waits except for reading a sample.
+ * @note   Each change of the heater is verified by the heater bit of the
+ *         status register.
+ *
+ * @param  Heater: Pointer to heater controller
+ * @param  Sample: Pointer to sample
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: A new sample is stored in Sample.
+ *         - SHT3x_NO_DATA: No sample is due.
+ *         - SHT3x_FAIL: Failed to read the sample or to switch the heater.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ */
+SHT3x_Result_t
+SHT3x_HeaterProcess(SHT3x_Heater_t *Heater, SHT3x_HeaterSample_t *Sample)
+{
+  SHT3x_Result_t Result = SHT3x_OK;
+  uint32_t Now = SHT3x_HeaterGetTime(Heater);
+  uint32_t Interval;
+  uint16_t Humidity;
+
+  if (SHT3x_HeaterDutyCycle(Heater, Now) != SHT3x_OK)
+    return SHT3x_FAIL;
+
+  if (!SHT3x_HeaterElapsed(Now, Heater->NextSample))
+    return SHT3x_NO_DATA;
+
+  Result = SHT3x_ReadSample(Heater->Handler, &Sample->Sample);
+  if (Result == SHT3x_NO_DATA)
+    return Result;
+
+  Interval = ((Heater->State == SHT3x_HEATER_IDLE) ?
+              Heater->Config.Interval : Heater->Config.RecoveryInterval) * 1000;
+  Heater->NextSample += Interval;
+  if (SHT3x_HeaterElapsed(Now, Heater->NextSample))
+    Heater->NextSample = Now + Interval;
+
+  if (Result != SHT3x_OK)
+    return Result;
+
+  if (Heater->Settling &&
+      SHT3x_HeaterElapsed(Now, Heater->HeaterOffTime +
+                               Heater->Config.SettleTime * 1000))
+    Heater->Settling = 0;
+
+  Sample->Timestamp = Now;
+  Sample->Biased = (Heater->State == SHT3x_HEATER_ON || Heater->Settling);
+  Sample->Recovering = (Heater->State != SHT3x_HEATER_IDLE);
+
+  Humidity = SHT3x_HeaterHumidity(&Sample->Sample);
+  if (Heater->State == SHT3x_HEATER_IDLE)
+  {
+    if (!Sample->Biased && Humidity >= Heater->Config.HumidityOn)
+    {
+      Heater->State = SHT3x_HEATER_ON;
+      Heater->RecoveryStart = Now;
+      Heater->PhaseEnd = Now + Heater->Config.OnTime * 1000;
+      Heater->NextSample = Now + Heater->Config.RecoveryInterval * 1000;
+      if (SHT3x_HeaterSwitch(Heater, 1) != SHT3x_OK)
+        return SHT3x_FAIL;
+    }
+  }
+  else if (!Sample->Biased && Humidity < Heater->Config.HumidityOff)
+  {
+    Heater->NextSample = Now + Heater->Config.Interval * 1000;
+    if (SHT3x_HeaterEndRecovery(Heater, Now) != SHT3x_OK)
+      return SHT3x_FAIL;
+  }
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Stop the recovery in progress and turn the heater off
+ * @param  Heater: Pointer to heater controller
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to turn the heater off.
+ */
+SHT3x_Result_t
+SHT3x_HeaterStop(SHT3x_Heater_t *Heater)
+{
+  return SHT3x_HeaterEndRecovery(Heater, SHT3x_HeaterGetTime(Heater));
+}
+
+
+/**
+ * @brief  Get the state of the heater controller
+ * @param  Heater: Pointer to heater controller
+ * @retval SHT3x_HeaterState_t
+ */
+SHT3x_HeaterState_t
+SHT3x_HeaterGetState(SHT3x_Heater_t *Heater)
+{
+  return Heater->State;
+}
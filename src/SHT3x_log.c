@@ -0,0 +1,332 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_log.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Packed sample records and binary log format of SHT3x
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "SHT3x_log.h"
+
+
+/* Private Constants ------------------------------------------------------------*/
+static const uint8_t SHT3x_LogMagic[4] = {'S', 'H', 'T', '3'};
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static void
+SHT3x_LogPut16(uint8_t *Buffer, uint16_t Value)
+{
+  Buffer[0] = (uint8_t)Value;
+  Buffer[1] = (uint8_t)(Value >> 8);
+}
+
+
+static uint16_t
+SHT3x_LogGet16(const uint8_t *Buffer)
+{
+  return (uint16_t)(Buffer[0] | ((uint16_t)Buffer[1] << 8));
+}
+
+
+
+/**
+ ==================================================================================
+                           ##### Record Functions #####                            
+ ==================================================================================
+ */
+
+/**
+ * @brief  Pack raw values of a sample to a record
+ * @param  Record: Pointer to record
+ * @param  Sample: Pointer to sample
+ * @retval None
+ */
+void
+SHT3x_RecordPack(SHT3x_Record_t *Record, const SHT3x_Sample_t *Sample)
+{
+  Record->TempRaw = Sample->TempRaw;
+  Record->HumRaw = Sample->HumRaw;
+}
+
+
+/**
+ * @brief  Unpack a record to a sample
+ * @param  Record: Pointer to record
+ * @param  Sample: Pointer to sample
+ * @param  Conversion: Combination of SHT3x_Conversion_t flags
+ * @retval None
+ */
+void
+SHT3x_RecordUnpack(const SHT3x_Record_t *Record, SHT3x_Sample_t *Sample,
+                   uint8_t Conversion)
+{
+  Sample->TempRaw = Record->TempRaw;
+  Sample->HumRaw = Record->HumRaw;
+  SHT3x_ConvertSample(Sample, Conversion);
+}
+
+
+/**
+ * @brief  Pack raw values of a sample to a record with time delta
+ * @param  Record: Pointer to record
+ * @param  Sample: Pointer to sample
+ * @param  TimeDelta: Time from the previous record (in any unit)
+ * @retval None
+ */
+void
+SHT3x_TimedRecordPack(SHT3x_TimedRecord_t *Record, const SHT3x_Sample_t *Sample,
+                      uint16_t TimeDelta)
+{
+  Record->TimeDelta = TimeDelta;
+  Record->TempRaw = Sample->TempRaw;
+  Record->HumRaw = Sample->HumRaw;
+}
+
+
+/**
+ * @brief  Unpack a record with time delta to a sample
+ * @param  Record: Pointer to record
+ * @param  Sample: Pointer to sample
+ * @param  Conversion: Combination of SHT3x_Conversion_t flags
+ * @retval Time delta of the record
+ */
+uint16_t
+SHT3x_TimedRecordUnpack(const SHT3x_TimedRecord_t *Record, SHT3x_Sample_t *Sample,
+                        uint8_t Conversion)
+{
+  Sample->TempRaw = Record->TempRaw;
+  Sample->HumRaw = Record->HumRaw;
+  SHT3x_ConvertSample(Sample, Conversion);
+
+  return Record->TimeDelta;
+}
+
+
+
+/**
+ ==================================================================================
+                             ##### Log Functions #####                             
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize a log writer from the current settings of a handler
+ * @param  Log: Pointer to log
+ * @param  Handler: Pointer to handler
+ * @param  RecordSize: SHT3X_RECORD_SIZE or SHT3X_TIMED_RECORD_SIZE
+ * @param  TimeUnit: Time delta unit in ms (1 to 65535, timed records only).
+ *                   The longest time delta is 65535 units.
+ * @param  StartTime: User defined start time stored in header
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_LogInit(SHT3x_Log_t *Log, const SHT3x_Handler_t *Handler,
+              uint8_t RecordSize, uint16_t TimeUnit, uint32_t StartTime)
+{
+  if (!Log || !Handler)
+    return SHT3x_INVALID_PARAM;
+
+  if (RecordSize == SHT3X_TIMED_RECORD_SIZE)
+  {
+    if (TimeUnit == 0)
+      return SHT3x_INVALID_PARAM;
+  }
+  else if (RecordSize != SHT3X_RECORD_SIZE)
+  {
+    return SHT3x_INVALID_PARAM;
+  }
+
+  Log->Header.RecordSize = RecordSize;
+  Log->Header.AddressI2C = Handler->AddressI2C;
+  Log->Header.Mode = (uint8_t)Handler->Mode;
+  Log->Header.Repeatability = (uint8_t)Handler->Repeatability;
+  Log->Header.Speed = (uint8_t)Handler->Speed;
+  Log->Header.TimeUnit = TimeUnit;
+  Log->Header.StartTime = StartTime;
+  Log->Started = 0;
+  Log->LastTime = 0;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Write the header of log
+ * @param  Log: Pointer to log
+ * @param  Buffer: Pointer to buffer of SHT3X_LOG_HEADER_SIZE bytes
+ * @retval Number of bytes written (SHT3X_LOG_HEADER_SIZE)
+ */
+uint8_t
+SHT3x_LogPutHeader(const SHT3x_Log_t *Log, uint8_t *Buffer)
+{
+  const SHT3x_LogHeader_t *Header = &Log->Header;
+  uint8_t i;
+
+  for (i = 0; i < sizeof(SHT3x_LogMagic); i++)
+    Buffer[i] = SHT3x_LogMagic[i];
+
+  Buffer[4] = SHT3X_LOG_VERSION;
+  Buffer[5] = Header->RecordSize;
+  Buffer[6] = Header->AddressI2C;
+  Buffer[7] = Header->Mode;
+  Buffer[8] = Header->Repeatability;
+  Buffer[9] = Header->Speed;
+  SHT3x_LogPut16(&Buffer[10], Header->TimeUnit);
+  SHT3x_LogPut16(&Buffer[12], (uint16_t)Header->StartTime);
+  SHT3x_LogPut16(&Buffer[14], (uint16_t)(Header->StartTime >> 16));
+
+  return SHT3X_LOG_HEADER_SIZE;
+}
+
+
+/**
+ * @brief  Write a record of log
+ * @note   Time delta is rounded down to whole TimeUnit and the remainder is
+ *         carried to the next record, so time does not drift. It is saturated
+ *         at 65535 units.
+ *
+ * @param  Log: Pointer to log
+ * @param  Sample: Pointer to sample
+ * @param  Time: Time of sample in ms (timed records only)
+ * @param  Buffer: Pointer to buffer of Header.RecordSize bytes
+ * 
+ * @retval Number of bytes written (Header.RecordSize)
+ */
+uint8_t
+SHT3x_LogPutRecord(SHT3x_Log_t *Log, const SHT3x_Sample_t *Sample,
+                   uint32_t Time, uint8_t *Buffer)
+{
+  uint32_t Delta;
+
+  if (Log->Header.RecordSize == SHT3X_RECORD_SIZE)
+  {
+    SHT3x_LogPut16(&Buffer[0], Sample->TempRaw);
+    SHT3x_LogPut16(&Buffer[2], Sample->HumRaw);
+    return SHT3X_RECORD_SIZE;
+  }
+
+  if (!Log->Started)
+  {
+    Log->Started = 1;
+    Log->LastTime = Time;
+  }
+
+  Delta = (Time - Log->LastTime) / Log->Header.TimeUnit;
+  if (Delta > 0xFFFF)
+    Delta = 0xFFFF;
+  Log->LastTime += Delta * Log->Header.TimeUnit;
+
+  SHT3x_LogPut16(&Buffer[0], (uint16_t)Delta);
+  SHT3x_LogPut16(&Buffer[2], Sample->TempRaw);
+  SHT3x_LogPut16(&Buffer[4], Sample->HumRaw);
+
+  return SHT3X_TIMED_RECORD_SIZE;
+}
+
+
+/**
+ * @brief  Read the header of log to initialize a log reader
+ * @param  Log: Pointer to log
+ * @param  Buffer: Pointer to log data
+ * @param  Size: Number of bytes available in Buffer
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_NO_DATA: Buffer is shorter than SHT3X_LOG_HEADER_SIZE.
+ *         - SHT3x_INVALID_PARAM: Magic, version or record size is invalid.
+ */
+SHT3x_Result_t
+SHT3x_LogGetHeader(SHT3x_Log_t *Log, const uint8_t *Buffer, uint32_t Size)
+{
+  SHT3x_LogHeader_t *Header = &Log->Header;
+  uint8_t i;
+
+  if (Size < SHT3X_LOG_HEADER_SIZE)
+    return SHT3x_NO_DATA;
+
+  for (i = 0; i < sizeof(SHT3x_LogMagic); i++)
+  {
+    if (Buffer[i] != SHT3x_LogMagic[i])
+      return SHT3x_INVALID_PARAM;
+  }
+
+  if (Buffer[4] != SHT3X_LOG_VERSION ||
+      (Buffer[5] != SHT3X_RECORD_SIZE && Buffer[5] != SHT3X_TIMED_RECORD_SIZE))
+    return SHT3x_INVALID_PARAM;
+
+  Header->RecordSize = Buffer[5];
+  Header->AddressI2C = Buffer[6];
+  Header->Mode = Buffer[7];
+  Header->Repeatability = Buffer[8];
+  Header->Speed = Buffer[9];
+  Header->TimeUnit = SHT3x_LogGet16(&Buffer[10]);
+  Header->StartTime = SHT3x_LogGet16(&Buffer[12]) |
+                      ((uint32_t)SHT3x_LogGet16(&Buffer[14]) << 16);
+  Log->Started = 0;
+  Log->LastTime = 0;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Read a record of log
+ * @param  Log: Pointer to log
+ * @param  Buffer: Pointer to record (Header.RecordSize bytes)
+ * @param  Sample: Pointer to sample
+ * @param  Conversion: Combination of SHT3x_Conversion_t flags
+ * 
+ * @retval Time of record in ms from the first record (0 for untimed records)
+ */
+uint32_t
+SHT3x_LogGetRecord(SHT3x_Log_t *Log, const uint8_t *Buffer, SHT3x_Sample_t *Sample,
+                   uint8_t Conversion)
+{
+  uint8_t Offset = 0;
+
+  if (Log->Header.RecordSize == SHT3X_TIMED_RECORD_SIZE)
+  {
+    Log->LastTime += (uint32_t)SHT3x_LogGet16(&Buffer[0]) * Log->Header.TimeUnit;
+    Offset = 2;
+  }
+
+  Sample->TempRaw = SHT3x_LogGet16(&Buffer[Offset]);
+  Sample->HumRaw = SHT3x_LogGet16(&Buffer[Offset + 2]);
+  SHT3x_ConvertSample(Sample, Conversion);
+
+  return Log->LastTime;
+}
@@ -0,0 +1,260 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_lowpower.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Low-power Single Shot acquisition of SHT3x sensor
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "SHT3x_lowpower.h"
+
+
+/* Private Constants ------------------------------------------------------------*/
+/**
+ * @brief  Typical supply current of the sensor (in nA)
+ */
+#define SHT3X_LOWPOWER_CURRENT_MEASURE  600000
+#define SHT3X_LOWPOWER_CURRENT_IDLE     200
+
+/**
+ * @brief  Extra sleeps if the sample is not ready in time
+ */
+#define SHT3X_LOWPOWER_RETRY_TIME   1000
+#define SHT3X_LOWPOWER_RETRY_COUNT  5
+
+
+/* Private Variables ------------------------------------------------------------*/
+/**
+ * @brief  Typical measurement duration in single shot mode (in us)
+ */
+static const uint16_t SHT3x_LowPowerMeasurementTime[3] =
+{
+  2500, 4500, 12500,
+};
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static uint32_t
+SHT3x_LowPowerGetTime(SHT3x_LowPower_t *LowPower)
+{
+  return LowPower->Handler->PlatformGetTime(LowPower->Handler->Context);
+}
+
+
+
+/**
+ ==================================================================================
+                          ##### Low-power Functions #####                          
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the low-power acquisition
+ * @note   Handler must be initialized and in Single Shot mode. Clock
+ *         stretching is disabled, so the bus is free during the measurement.
+ * @note   If PlatformGetTime is set, the time spent on the bus is subtracted
+ *         from sleep times. It must keep counting while the MCU sleeps (e.g.
+ *         RTC or LPTIM instead of SysTick), otherwise leave it NULL.
+ *
+ * @param  LowPower: Pointer to low-power acquisition
+ * @param  Handler: Pointer to handler
+ * @param  Sleep: Sleep function
+ * @param  Context: User context passed to Sleep
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_LowPowerInit(SHT3x_LowPower_t *LowPower, SHT3x_Handler_t *Handler,
+                   SHT3x_LowPowerSleep_t Sleep, void *Context)
+{
+  if (!Sleep || Handler->Mode != SHT3x_MODE_SINGLESHOT)
+    return SHT3x_INVALID_PARAM;
+
+  if (SHT3x_SetClockStretching(Handler, 0) != SHT3x_OK)
+    return SHT3x_INVALID_PARAM;
+
+  LowPower->Handler = Handler;
+  LowPower->Sleep = Sleep;
+  LowPower->Context = Context;
+  LowPower->Retries = 0;
+  LowPower->CycleStart = Handler->PlatformGetTime ?
+                         SHT3x_LowPowerGetTime(LowPower) : 0;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Read a sample and sleep during the measurement
+ * @note   The measurement is started, the MCU sleeps for the remaining
+ *         measurement time and the sample is fetched. If the sample is not
+ *         ready, the MCU sleeps 1 ms more (up to 5 times). The sensor goes to
+ *         idle state automatically after the measurement.
+ *
+ * @param  LowPower: Pointer to low-power acquisition
+ * @param  Sample: Pointer to sample buffer
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data or sample was not
+ *                       ready after retries.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ */
+SHT3x_Result_t
+SHT3x_LowPowerRead(SHT3x_LowPower_t *LowPower, SHT3x_Sample_t *Sample)
+{
+  SHT3x_Handler_t *Handler = LowPower->Handler;
+  SHT3x_Result_t Result = SHT3x_OK;
+  uint32_t Wait;
+
+  Result = SHT3x_StartMeasurement(Handler);
+  if (Result != SHT3x_OK)
+    return Result;
+
+  if (Handler->PlatformGetTime)
+    Wait = SHT3x_NextSampleDueIn(Handler);
+  else
+    Wait = SHT3x_GetMeasurementTime(Handler->Repeatability);
+  if (Wait)
+    LowPower->Sleep(LowPower->Context, Wait);
+
+  for (uint8_t Counter = 0; Counter <= SHT3X_LOWPOWER_RETRY_COUNT; Counter++)
+  {
+    Result = SHT3x_FetchSample(Handler, Sample);
+    if (Result != SHT3x_NO_DATA)
+      return Result;
+
+    if (Counter == SHT3X_LOWPOWER_RETRY_COUNT)
+      break;
+
+    LowPower->Retries++;
+    LowPower->Sleep(LowPower->Context, SHT3X_LOWPOWER_RETRY_TIME);
+  }
+
+  return SHT3x_FAIL;
+}
+
+
+/**
+ * @brief  Read a sample and sleep until the next sample interval
+ * @note   If PlatformGetTime is set, cycles are kept on a grid of Interval
+ *         from SHT3x_LowPowerInit(). Otherwise the maximum measurement time
+ *         is subtracted from Interval. The function sleeps even if reading
+ *         the sample fails.
+ *
+ * @param  LowPower: Pointer to low-power acquisition
+ * @param  Sample: Pointer to sample buffer
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ *         - SHT3x_INVALID_PARAM: Interval is 0.
+ */
+SHT3x_Result_t
+SHT3x_LowPowerCycle(SHT3x_LowPower_t *LowPower, SHT3x_Sample_t *Sample)
+{
+  SHT3x_Result_t Result = SHT3x_OK;
+  uint32_t Interval = LowPower->Interval * 1000;
+  uint32_t Now;
+  int32_t Wait;
+
+  if (!Interval)
+    return SHT3x_INVALID_PARAM;
+
+  Result = SHT3x_LowPowerRead(LowPower, Sample);
+
+  if (LowPower->Handler->PlatformGetTime)
+  {
+    Now = SHT3x_LowPowerGetTime(LowPower);
+    LowPower->CycleStart += Interval;
+    Wait = (int32_t)(LowPower->CycleStart - Now);
+    if (Wait <= 0)
+    {
+      // Behind the grid, start a new one from now
+      LowPower->CycleStart = Now;
+      Wait = 0;
+    }
+  }
+  else
+  {
+    Wait = (int32_t)(Interval -
+        SHT3x_GetMeasurementTime(LowPower->Handler->Repeatability));
+  }
+
+  if (Wait > 0)
+    LowPower->Sleep(LowPower->Context, (uint32_t)Wait);
+
+  return Result;
+}
+
+
+/**
+ * @brief  Estimate the time and energy consumption of the sensor
+ * @param  Repeatability: Specify repeatability level
+ * @param  Interval: Sample interval in ms (up to 4000000 ms)
+ * @param  Voltage: Supply voltage in mV
+ * @param  Estimate: Pointer to estimate
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_LowPowerEstimate(SHT3x_Repeatability_t Repeatability, uint32_t Interval,
+                       uint16_t Voltage, SHT3x_LowPowerEstimate_t *Estimate)
+{
+  uint32_t Time;
+  uint64_t Charge; // in fC (nA * us)
+
+  if (Repeatability > SHT3x_REPEATABILITY_HIGH || Interval > 4000000)
+    return SHT3x_INVALID_PARAM;
+
+  Time = SHT3x_LowPowerMeasurementTime[Repeatability];
+  Interval *= 1000;
+  if (Interval < Time)
+    return SHT3x_INVALID_PARAM;
+
+  Charge = (uint64_t)SHT3X_LOWPOWER_CURRENT_MEASURE * Time +
+           (uint64_t)SHT3X_LOWPOWER_CURRENT_IDLE * (Interval - Time);
+
+  Estimate->MeasurementTime = Time;
+  Estimate->MeasurementTimeMax = SHT3x_GetMeasurementTime(Repeatability);
+  Estimate->Charge = (uint32_t)(Charge / 1000000);
+  Estimate->Energy = (uint32_t)((Charge * Voltage) / 1000000000);
+  Estimate->AverageCurrent = (uint32_t)(Charge / Interval);
+
+  return SHT3x_OK;
+}
@@ -0,0 +1,241 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_periodic.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  SHT3x periodic acquisition engine
+ *         Functionalities of the this file:
+ *          + Fetch samples of Periodic and ART modes at the acquisition rate
+ *          + Lock-free single producer single consumer ring buffer of samples
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Includes ---------------------------------------------------------------------*/
+#include "SHT3x_periodic.h"
+
+
+
+/* Private Macro ----------------------------------------------------------------*/
+/**
+ * @brief  Keep the compiler (and the CPU) from reordering buffer and index
+ *         accesses of the ring buffer
+ */
+#if defined(__AVR__)
+#define SHT3X_MEMORY_BARRIER()  __asm__ __volatile__ ("" ::: "memory")
+#elif defined(__GNUC__)
+#define SHT3X_MEMORY_BARRIER()  __sync_synchronize()
+#else
+#define SHT3X_MEMORY_BARRIER()
+#endif
+
+
+
+/**
+ ==================================================================================
+                         ##### Ring Buffer Functions #####                         
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize ring buffer
+ * @param  Ring: Pointer to ring buffer
+ * @param  Buffer: Pointer to array of samples supplied by caller
+ * @param  Size: Number of items of Buffer. It must be a power of 2
+ *               (up to 32768).
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_RingInit(SHT3x_Ring_t *Ring, SHT3x_TimedSample_t *Buffer, uint16_t Size)
+{
+  if (!Buffer || !Size || (Size & (Size - 1)) || Size > 32768)
+    return SHT3x_INVALID_PARAM;
+
+  Ring->Buffer = Buffer;
+  Ring->Size = Size;
+  Ring->Head = 0;
+  Ring->Tail = 0;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Push a sample to ring buffer (producer side)
+ * @param  Ring: Pointer to ring buffer
+ * @param  Sample: Pointer to sample
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Ring buffer is full.
+ */
+SHT3x_Result_t
+SHT3x_RingPush(SHT3x_Ring_t *Ring, const SHT3x_TimedSample_t *Sample)
+{
+  uint16_t Head = Ring->Head;
+
+  if ((uint16_t)(Head - Ring->Tail) >= Ring->Size)
+    return SHT3x_FAIL;
+
+  Ring->Buffer[Head & (Ring->Size - 1)] = *Sample;
+  SHT3X_MEMORY_BARRIER();
+  Ring->Head = Head + 1;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Pop samples from ring buffer (consumer side)
+ * @param  Ring: Pointer to ring buffer
+ * @param  Samples: Pointer to output array
+ * @param  Count: Maximum number of samples to pop
+ * @retval Number of samples popped
+ */
+uint16_t
+SHT3x_RingPop(SHT3x_Ring_t *Ring, SHT3x_TimedSample_t *Samples, uint16_t Count)
+{
+  uint16_t Tail = Ring->Tail;
+  uint16_t Available = (uint16_t)(Ring->Head - Tail);
+  uint16_t i = 0;
+
+  if (Count > Available)
+    Count = Available;
+
+  SHT3X_MEMORY_BARRIER();
+  for (i = 0; i < Count; i++, Tail++)
+    Samples[i] = Ring->Buffer[Tail & (Ring->Size - 1)];
+
+  SHT3X_MEMORY_BARRIER();
+  Ring->Tail = Tail;
+
+  return Count;
+}
+
+
+/**
+ * @brief  Get number of samples in ring buffer
+ * @param  Ring: Pointer to ring buffer
+ * @retval Number of samples
+ */
+uint16_t
+SHT3x_RingCount(SHT3x_Ring_t *Ring)
+{
+  return (uint16_t)(Ring->Head - Ring->Tail);
+}
+
+
+
+/**
+ ==================================================================================
+                     ##### Periodic Acquisition Functions #####                    
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize periodic acquisition engine
+ * @note   The sensor must be set to Periodic or ART mode before and
+ *         PlatformGetTime of the handler must be set.
+ *
+ * @param  Periodic: Pointer to engine
+ * @param  Handler: Pointer to handler
+ * @param  Ring: Pointer to initialized ring buffer
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_PeriodicInit(SHT3x_Periodic_t *Periodic,
+                   SHT3x_Handler_t *Handler, SHT3x_Ring_t *Ring)
+{
+  if (!Handler->PlatformGetTime || !Ring)
+    return SHT3x_INVALID_PARAM;
+
+  if (Handler->Mode == SHT3x_MODE_SINGLESHOT || !Handler->SamplePeriod)
+    return SHT3x_INVALID_PARAM;
+
+  Periodic->Handler = Handler;
+  Periodic->Ring = Ring;
+  Periodic->Dropped = 0;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Run periodic acquisition engine (producer side)
+ * @note   Call this function frequently (e.g. in main loop or a task). The
+ *         sensor is accessed only when a new sample is due on the sample grid
+ *         of the handler (see SHT3x_NextSampleDueIn()).
+ *
+ * @param  Periodic: Pointer to engine
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: A sample is pushed to ring buffer.
+ *         - SHT3x_NO_DATA: No sample is due yet or the due sample is late
+ *           (it is fetched again on the next call).
+ *         - SHT3x_FAIL: Failed to send or receive data or ring buffer is full.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ */
+SHT3x_Result_t
+SHT3x_PeriodicProcess(SHT3x_Periodic_t *Periodic)
+{
+  SHT3x_Handler_t *Handler = Periodic->Handler;
+  SHT3x_TimedSample_t TimedSample;
+  SHT3x_Result_t Result = SHT3x_OK;
+  uint32_t Now = 0;
+
+  // The handler keeps the sample grid (see SHT3x_NextSampleDueIn())
+  if (SHT3x_NextSampleDueIn(Handler))
+    return SHT3x_NO_DATA;
+
+  Now = Handler->PlatformGetTime(Handler->Context);
+  Result = SHT3x_ReadSample(Handler, &TimedSample.Sample);
+  if (Result != SHT3x_OK)
+    return Result;
+
+  TimedSample.Timestamp = Now;
+  if (SHT3x_RingPush(Periodic->Ring, &TimedSample) != SHT3x_OK)
+  {
+    Periodic->Dropped++;
+    return SHT3x_FAIL;
+  }
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Get the time until the next fetch
+ * @note   It can be used to sleep between calls of SHT3x_PeriodicProcess().
+ * @param  Periodic: Pointer to engine
+ * @retval Time in us (0 if a fetch is due)
+ */
+uint32_t
+SHT3x_PeriodicTimeToNext(SHT3x_Periodic_t *Periodic)
+{
+  return SHT3x_NextSampleDueIn(Periodic->Handler);
+}
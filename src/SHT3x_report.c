@@ -0,0 +1,335 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_report.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Report-on-change filter and delta encoding of SHT3x samples
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "SHT3x_report.h"
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static uint16_t
+SHT3x_ReportDistance(uint16_t A, uint16_t B)
+{
+  return (A > B) ? (A - B) : (B - A);
+}
+
+
+/**
+ * @brief  Write difference of Value from Previous as a zigzag varint
+ * @retval Number of bytes written (1 to 3)
+ */
+static uint8_t
+SHT3x_DeltaPut(uint16_t Value, uint16_t Previous, uint8_t *Buffer)
+{
+  uint16_t Delta = (uint16_t)(Value - Previous);
+  uint16_t Zigzag = (uint16_t)((Delta << 1) ^ ((Delta & 0x8000) ? 0xFFFF : 0x0000));
+  uint8_t Size = 0;
+
+  while (Zigzag >= 0x80)
+  {
+    Buffer[Size++] = (uint8_t)(Zigzag | 0x80);
+    Zigzag >>= 7;
+  }
+  Buffer[Size++] = (uint8_t)Zigzag;
+
+  return Size;
+}
+
+
+/**
+ * @brief  Read a zigzag varint and add it to Previous
+ * @retval Number of bytes read (0: truncated or invalid)
+ */
+static uint8_t
+SHT3x_DeltaGet(const uint8_t *Buffer, uint16_t Size, uint16_t Previous,
+               uint16_t *Value)
+{
+  uint32_t Zigzag = 0;
+  uint8_t i;
+
+  for (i = 0; i < 3 && i < Size; i++)
+  {
+    Zigzag |= (uint32_t)(Buffer[i] & 0x7F) << (7 * i);
+    if (!(Buffer[i] & 0x80))
+    {
+      if (Zigzag > 0xFFFF)
+        return 0;
+      *Value = (uint16_t)(Previous + ((Zigzag & 1) ? ~(Zigzag >> 1) : (Zigzag >> 1)));
+      return i + 1;
+    }
+  }
+
+  return 0;
+}
+
+
+
+/**
+ ==================================================================================
+                           ##### Report Functions #####                            
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the report-on-change filter
+ * @note   Handler must be initialized. PlatformGetTime must be set if Heartbeat
+ *         is not 0.
+ *
+ * @param  Report: Pointer to filter
+ * @param  Handler: Pointer to handler
+ * @param  TempDeadband: Temperature deadband in raw units
+ * @param  HumDeadband: Humidity deadband in raw units
+ * @param  Heartbeat: Heartbeat interval in ms (0: no heartbeat)
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_ReportInit(SHT3x_Report_t *Report, SHT3x_Handler_t *Handler,
+                 uint16_t TempDeadband, uint16_t HumDeadband, uint32_t Heartbeat)
+{
+  if (!Report || !Handler)
+    return SHT3x_INVALID_PARAM;
+
+  if (Heartbeat && !Handler->PlatformGetTime)
+    return SHT3x_INVALID_PARAM;
+
+  Report->Handler = Handler;
+  Report->TempDeadband = TempDeadband;
+  Report->HumDeadband = HumDeadband;
+  Report->Heartbeat = Heartbeat;
+  Report->Delivered = 0;
+  Report->Suppressed = 0;
+  Report->Valid = 0;
+  Report->LastTempRaw = 0;
+  Report->LastHumRaw = 0;
+  Report->LastTime = 0;
+  Report->Elapsed = 0;
+  Report->ElapsedUs = 0;
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Check if a sample passes the filter
+ * @note   A sample passes if it is the first one, if TempRaw or HumRaw differs
+ *         from the last delivered sample more than its deadband or if the
+ *         heartbeat interval is elapsed since the last delivered sample.
+ *
+ * @param  Report: Pointer to filter
+ * @param  Sample: Pointer to sample (only TempRaw and HumRaw are used)
+ * 
+ * @retval 1: Sample must be delivered, 0: Sample is suppressed
+ */
+uint8_t
+SHT3x_ReportFilter(SHT3x_Report_t *Report, const SHT3x_Sample_t *Sample)
+{
+  uint32_t Now = 0;
+  uint32_t Us = 0;
+  uint8_t Deliver = 0;
+
+  if (Report->Heartbeat)
+  {
+    // Count elapsed ms, so heartbeats longer than the wrap time of the us
+    // clock work too
+    Now = Report->Handler->PlatformGetTime(Report->Handler->Context);
+    Us = (Now - Report->LastTime) + Report->ElapsedUs;
+    Report->LastTime = Now;
+    Report->ElapsedUs = (uint16_t)(Us % 1000);
+    Us /= 1000;
+    Report->Elapsed = (Report->Elapsed > UINT32_MAX - Us) ?
+                      UINT32_MAX : (Report->Elapsed + Us);
+  }
+
+  if (!Report->Valid ||
+      SHT3x_ReportDistance(Sample->TempRaw, Report->LastTempRaw) > Report->TempDeadband ||
+      SHT3x_ReportDistance(Sample->HumRaw, Report->LastHumRaw) > Report->HumDeadband)
+    Deliver = 1;
+  else if (Report->Heartbeat && Report->Elapsed >= Report->Heartbeat)
+    Deliver = 1;
+
+  if (!Deliver)
+  {
+    Report->Suppressed++;
+    return 0;
+  }
+
+  Report->Valid = 1;
+  Report->LastTempRaw = Sample->TempRaw;
+  Report->LastHumRaw = Sample->HumRaw;
+  Report->Elapsed = 0;
+  Report->ElapsedUs = 0;
+  Report->Delivered++;
+
+  return 1;
+}
+
+
+/**
+ * @brief  Read a sample and deliver it only if it passes the filter
+ * @note   The sample is converted (see SHT3x_SetConversion()) only if it is
+ *         delivered.
+ *
+ * @param  Report: Pointer to filter
+ * @param  Sample: Pointer to sample
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: A new sample is delivered.
+ *         - SHT3x_NO_DATA: The sample is suppressed (only raw values are valid)
+ *           or no measurement data is present.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ */
+SHT3x_Result_t
+SHT3x_ReportReadSample(SHT3x_Report_t *Report, SHT3x_Sample_t *Sample)
+{
+  SHT3x_Handler_t *Handler = Report->Handler;
+  uint8_t Conversion = Handler->Conversion;
+  SHT3x_Result_t Result;
+
+  // Suppressed samples are not converted
+  Handler->Conversion = SHT3x_CONVERSION_RAW;
+  Result = SHT3x_ReadSample(Handler, Sample);
+  Handler->Conversion = Conversion;
+
+  if (Result != SHT3x_OK)
+    return Result;
+
+  if (!SHT3x_ReportFilter(Report, Sample))
+    return SHT3x_NO_DATA;
+
+  SHT3x_ConvertSample(Sample, Conversion);
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Deliver the next sample whatever its value is
+ * @param  Report: Pointer to filter
+ * @retval None
+ */
+void
+SHT3x_ReportForce(SHT3x_Report_t *Report)
+{
+  Report->Valid = 0;
+}
+
+
+
+/**
+ ==================================================================================
+                       ##### Delta Encoding Functions #####                        
+ ==================================================================================
+ */
+
+/**
+ * @brief  Start a new delta encoded stream
+ * @note   Encoder and decoder must be started together (e.g. at the start of
+ *         each packet, so packets can be decoded one by one).
+ *
+ * @param  Delta: Pointer to encoder/decoder
+ * 
+ * @retval None
+ */
+void
+SHT3x_DeltaInit(SHT3x_Delta_t *Delta)
+{
+  Delta->TempRaw = 0;
+  Delta->HumRaw = 0;
+}
+
+
+/**
+ * @brief  Encode raw values of a sample
+ * @param  Delta: Pointer to encoder
+ * @param  Sample: Pointer to sample (only TempRaw and HumRaw are used)
+ * @param  Buffer: Pointer to buffer of at least SHT3X_DELTA_MAX_SIZE bytes
+ * 
+ * @retval Number of bytes written to Buffer (2 to SHT3X_DELTA_MAX_SIZE)
+ */
+uint8_t
+SHT3x_DeltaEncode(SHT3x_Delta_t *Delta, const SHT3x_Sample_t *Sample,
+                  uint8_t *Buffer)
+{
+  uint8_t Size;
+
+  Size = SHT3x_DeltaPut(Sample->TempRaw, Delta->TempRaw, Buffer);
+  Size += SHT3x_DeltaPut(Sample->HumRaw, Delta->HumRaw, Buffer + Size);
+
+  Delta->TempRaw = Sample->TempRaw;
+  Delta->HumRaw = Sample->HumRaw;
+
+  return Size;
+}
+
+
+/**
+ * @brief  Decode raw values of a sample
+ * @note   Only TempRaw and HumRaw of the sample are set. Use
+ *         SHT3x_ConvertSample() to convert them.
+ *
+ * @param  Delta: Pointer to decoder
+ * @param  Buffer: Pointer to encoded data
+ * @param  Size: Number of bytes available in Buffer
+ * @param  Sample: Pointer to sample
+ * 
+ * @retval Number of bytes read from Buffer (0: record is truncated or invalid)
+ */
+uint8_t
+SHT3x_DeltaDecode(SHT3x_Delta_t *Delta, const uint8_t *Buffer, uint16_t Size,
+                  SHT3x_Sample_t *Sample)
+{
+  uint16_t TempRaw = 0;
+  uint16_t HumRaw = 0;
+  uint8_t TempSize;
+  uint8_t HumSize;
+
+  TempSize = SHT3x_DeltaGet(Buffer, Size, Delta->TempRaw, &TempRaw);
+  if (!TempSize)
+    return 0;
+
+  HumSize = SHT3x_DeltaGet(Buffer + TempSize, Size - TempSize, Delta->HumRaw, &HumRaw);
+  if (!HumSize)
+    return 0;
+
+  Delta->TempRaw = Sample->TempRaw = TempRaw;
+  Delta->HumRaw = Sample->HumRaw = HumRaw;
+
+  return TempSize + HumSize;
+}
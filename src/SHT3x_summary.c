@@ -0,0 +1,430 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_summary.c
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Streaming statistics (mean, min, max, dew point) of SHT3x samples
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include "SHT3x_summary.h"
+
+
+/* Private Constants ------------------------------------------------------------*/
+/**
+ * @brief  Magnus coefficients (a = 17.62, b = 243.12 C) and other constants
+ *         in fixed point
+ */
+#define SHT3X_SUMMARY_MAGNUS_A      1154744L  // a in 1/65536
+#define SHT3X_SUMMARY_MAGNUS_B      24312L    // b in 0.01 C
+#define SHT3X_SUMMARY_LOG2_10000    435412L   // log2(10000) in 1/32768
+#define SHT3X_SUMMARY_LN2           45426L    // ln(2) in 1/65536
+#define SHT3X_SUMMARY_LOG2E         94548L    // log2(e) in 1/65536
+#define SHT3X_SUMMARY_ABS_HUMIDITY  13244700L // 216.7 * 6.112 in 0.0001 g.K/m^3
+#define SHT3X_SUMMARY_KELVIN        27315L    // 0 C in 0.01 K
+
+
+
+/**
+ ==================================================================================
+                           ##### Private Functions #####                           
+ ==================================================================================
+ */
+
+static int16_t
+SHT3x_SummaryTemperature(uint16_t TempRaw)
+{
+  return (int16_t)((int32_t)(((uint32_t)TempRaw * 17500UL + 32768UL) >> 16) - 4500);
+}
+
+
+static uint16_t
+SHT3x_SummaryHumidity(uint16_t HumRaw)
+{
+  return (uint16_t)(((uint32_t)HumRaw * 10000UL + 32768UL) >> 16);
+}
+
+
+/**
+ * @brief  Natural logarithm of relative humidity (0.01 to 100 %) as a fraction
+ * @retval ln(Humidity / 10000) in 1/65536
+ */
+static int32_t
+SHT3x_SummaryLn(uint16_t Humidity)
+{
+  uint32_t Mantissa = Humidity;
+  int32_t Log2 = 15;
+  uint8_t i;
+
+  // Normalize to [1, 2) in 1/32768
+  while (Mantissa < 0x8000UL)
+  {
+    Mantissa <<= 1;
+    Log2--;
+  }
+  Log2 <<= 15;
+
+  // Fraction of log2 bit by bit by squaring the mantissa
+  for (i = 0; i < 15; i++)
+  {
+    Mantissa = (Mantissa * Mantissa) >> 15;
+    if (Mantissa >= 0x10000UL)
+    {
+      Mantissa >>= 1;
+      Log2 += 1L << (14 - i);
+    }
+  }
+
+  return (int32_t)(((int64_t)(Log2 - SHT3X_SUMMARY_LOG2_10000) *
+                    SHT3X_SUMMARY_LN2) >> 15);
+}
+
+
+/**
+ * @brief  Exponential function in fixed point
+ * @param  X: Exponent in 1/65536 (-20 to 10)
+ * @retval exp(X) in 1/65536
+ */
+static uint32_t
+SHT3x_SummaryExp(int32_t X)
+{
+  int32_t Exponent = (int32_t)(((int64_t)X * SHT3X_SUMMARY_LOG2E) >> 16);
+  int32_t Integer = Exponent >> 16;
+  uint32_t Fraction = (uint32_t)Exponent & 0xFFFFUL;
+  uint32_t Power;
+
+  // 2^Fraction by a cubic polynomial (error < 0.015 %)
+  Power = 5191;
+  Power = 14712 + ((Power * Fraction) >> 16);
+  Power = 45617 + ((Power * Fraction) >> 16);
+  Power = 65536 + ((Power * Fraction) >> 16);
+
+  if (Integer >= 0)
+    return Power << Integer;
+  if (Integer <= -32)
+    return 0;
+  return Power >> -Integer;
+}
+
+
+static int32_t
+SHT3x_SummaryClampTemp(int16_t Temperature)
+{
+  if (Temperature < -4500)
+    return -4500;
+  if (Temperature > 13000)
+    return 13000;
+  return Temperature;
+}
+
+
+/**
+ * @brief  Magnus term ln(RH) + a * T / (b + T)
+ * @retval Result in 1/65536
+ */
+static int32_t
+SHT3x_SummaryMagnus(int16_t Temperature, uint16_t Humidity)
+{
+  int32_t Temp = SHT3x_SummaryClampTemp(Temperature);
+
+  if (Humidity == 0)
+    Humidity = 1;
+  else if (Humidity > 10000)
+    Humidity = 10000;
+
+  return SHT3x_SummaryLn(Humidity) +
+         (int32_t)((SHT3X_SUMMARY_MAGNUS_A * (int64_t)Temp) /
+                   (SHT3X_SUMMARY_MAGNUS_B + Temp));
+}
+
+
+static int16_t
+SHT3x_SummaryMean(int32_t Sum, uint16_t Count)
+{
+  if (Sum >= 0)
+    return (int16_t)((Sum + Count / 2) / Count);
+  return (int16_t)((Sum - Count / 2) / Count);
+}
+
+
+
+/**
+ ==================================================================================
+                           ##### Summary Functions #####                           
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the summary
+ * @note   All calculations are done in integer math and each sample is added
+ *         in O(1) time in both modes.
+ *
+ * @param  Summary: Pointer to summary
+ * @param  Mode: Averaging mode
+ * @param  Length:
+ *         - SHT3x_SUMMARY_WINDOW: Number of samples of the window (1 to 65535)
+ *         - SHT3x_SUMMARY_EMA: N of alpha = 1 / 2^N (1 to 15)
+ * @param  Buffer: Window buffer of Length slots (SHT3x_SUMMARY_WINDOW only,
+ *                 NULL for SHT3x_SUMMARY_EMA)
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_SummaryInit(SHT3x_Summary_t *Summary, SHT3x_SummaryMode_t Mode,
+                  uint16_t Length, SHT3x_SummaryPoint_t *Buffer)
+{
+  if (!Summary)
+    return SHT3x_INVALID_PARAM;
+
+  if (Mode == SHT3x_SUMMARY_WINDOW)
+  {
+    if (!Buffer || Length == 0)
+      return SHT3x_INVALID_PARAM;
+  }
+  else if (Mode == SHT3x_SUMMARY_EMA)
+  {
+    if (Length == 0 || Length > 15)
+      return SHT3x_INVALID_PARAM;
+  }
+  else
+  {
+    return SHT3x_INVALID_PARAM;
+  }
+
+  Summary->Mode = Mode;
+  Summary->Buffer = Buffer;
+  Summary->Length = Length;
+  Summary->Index = 0;
+  Summary->Filled = 0;
+  Summary->TempAcc = 0;
+  Summary->HumAcc = 0;
+  SHT3x_SummaryReset(Summary);
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Add a sample to the summary
+ * @note   Only TempRaw and HumRaw of the sample are used, so the conversions
+ *         of the handler can be disabled.
+ *
+ * @param  Summary: Pointer to summary
+ * @param  Sample: Pointer to sample
+ * 
+ * @retval None
+ */
+void
+SHT3x_SummaryAdd(SHT3x_Summary_t *Summary, const SHT3x_Sample_t *Sample)
+{
+  int16_t Temp = SHT3x_SummaryTemperature(Sample->TempRaw);
+  uint16_t Hum = SHT3x_SummaryHumidity(Sample->HumRaw);
+  SHT3x_SummaryPoint_t *Slot;
+
+  if (Summary->Mode == SHT3x_SUMMARY_WINDOW)
+  {
+    Slot = &Summary->Buffer[Summary->Index];
+    if (Summary->Filled == Summary->Length)
+    {
+      Summary->TempAcc -= Slot->Temperature;
+      Summary->HumAcc -= Slot->Humidity;
+    }
+    else
+    {
+      Summary->Filled++;
+    }
+
+    Slot->Temperature = Temp;
+    Slot->Humidity = Hum;
+    Summary->TempAcc += Temp;
+    Summary->HumAcc += Hum;
+
+    Summary->Index++;
+    if (Summary->Index == Summary->Length)
+      Summary->Index = 0;
+  }
+  else if (Summary->Filled == 0)
+  {
+    Summary->TempAcc = (int32_t)Temp * 65536;
+    Summary->HumAcc = (int32_t)Hum * 65536;
+    Summary->Filled = 1;
+  }
+  else
+  {
+    Summary->TempAcc += ((int32_t)Temp * 65536 - Summary->TempAcc) >> Summary->Length;
+    Summary->HumAcc += ((int32_t)Hum * 65536 - Summary->HumAcc) >> Summary->Length;
+  }
+
+  if (Summary->Count == 0)
+  {
+    Summary->TempMin = Summary->TempMax = Temp;
+    Summary->HumMin = Summary->HumMax = Hum;
+  }
+  else
+  {
+    if (Temp < Summary->TempMin)
+      Summary->TempMin = Temp;
+    if (Temp > Summary->TempMax)
+      Summary->TempMax = Temp;
+    if (Hum < Summary->HumMin)
+      Summary->HumMin = Hum;
+    if (Hum > Summary->HumMax)
+      Summary->HumMax = Hum;
+  }
+  Summary->Count++;
+}
+
+
+/**
+ * @brief  Read a sample by SHT3x_ReadSample() and add it to the summary
+ * @param  Summary: Pointer to summary
+ * @param  Handler: Pointer to handler
+ * @param  Sample: Pointer to sample (may be NULL)
+ * 
+ * @retval SHT3x_Result_t (same as SHT3x_ReadSample())
+ */
+SHT3x_Result_t
+SHT3x_SummaryReadSample(SHT3x_Summary_t *Summary, SHT3x_Handler_t *Handler,
+                        SHT3x_Sample_t *Sample)
+{
+  SHT3x_Sample_t Buffer;
+  SHT3x_Result_t Result;
+
+  if (!Sample)
+    Sample = &Buffer;
+
+  Result = SHT3x_ReadSample(Handler, Sample);
+  if (Result == SHT3x_OK)
+    SHT3x_SummaryAdd(Summary, Sample);
+
+  return Result;
+}
+
+
+/**
+ * @brief  Get the summary report
+ * @note   Dew point and absolute humidity are calculated here from the means,
+ *         not for each sample.
+ *
+ * @param  Summary: Pointer to summary
+ * @param  Result: Pointer to report
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_NO_DATA: No sample is added since the last reset.
+ */
+SHT3x_Result_t
+SHT3x_SummaryGet(const SHT3x_Summary_t *Summary, SHT3x_SummaryResult_t *Result)
+{
+  if (Summary->Count == 0)
+    return SHT3x_NO_DATA;
+
+  Result->Count = Summary->Count;
+  Result->TempMin = Summary->TempMin;
+  Result->TempMax = Summary->TempMax;
+  Result->HumMin = Summary->HumMin;
+  Result->HumMax = Summary->HumMax;
+
+  if (Summary->Mode == SHT3x_SUMMARY_WINDOW)
+  {
+    Result->TempMean = SHT3x_SummaryMean(Summary->TempAcc, Summary->Filled);
+    Result->HumMean = (uint16_t)SHT3x_SummaryMean(Summary->HumAcc, Summary->Filled);
+  }
+  else
+  {
+    Result->TempMean = (int16_t)((Summary->TempAcc + 32768) >> 16);
+    Result->HumMean = (uint16_t)((Summary->HumAcc + 32768) >> 16);
+  }
+
+  Result->DewPoint = SHT3x_DewPoint(Result->TempMean, Result->HumMean);
+  Result->AbsoluteHumidity =
+      SHT3x_AbsoluteHumidity(Result->TempMean, Result->HumMean);
+
+  return SHT3x_OK;
+}
+
+
+/**
+ * @brief  Start a new report period
+ * @note   Count, minimums and maximums are cleared. The window and the EMA
+ *         are kept, so the means stay continuous over periods.
+ *
+ * @param  Summary: Pointer to summary
+ * 
+ * @retval None
+ */
+void
+SHT3x_SummaryReset(SHT3x_Summary_t *Summary)
+{
+  Summary->Count = 0;
+  Summary->TempMin = 0;
+  Summary->TempMax = 0;
+  Summary->HumMin = 0;
+  Summary->HumMax = 0;
+}
+
+
+/**
+ * @brief  Calculate dew point by the Magnus formula (over water)
+ * @note   Integer math only. Error is less than 0.02 C compared to the same
+ *         formula in floating point math.
+ *
+ * @param  Temperature: Temperature in 0.01 C
+ * @param  Humidity: Relative humidity in 0.01 %
+ * 
+ * @retval Dew point in 0.01 C
+ */
+int16_t
+SHT3x_DewPoint(int16_t Temperature, uint16_t Humidity)
+{
+  int32_t Magnus = SHT3x_SummaryMagnus(Temperature, Humidity);
+
+  return (int16_t)((SHT3X_SUMMARY_MAGNUS_B * (int64_t)Magnus) /
+                   (SHT3X_SUMMARY_MAGNUS_A - Magnus));
+}
+
+
+/**
+ * @brief  Calculate absolute humidity (water vapor density)
+ * @note   Integer math only. Uses the same Magnus formula as SHT3x_DewPoint().
+ *         Error is less than 0.2 % or 0.01 g/m^3.
+ *
+ * @param  Temperature: Temperature in 0.01 C
+ * @param  Humidity: Relative humidity in 0.01 %
+ * 
+ * @retval Absolute humidity in 0.01 g/m^3
+ */
+uint32_t
+SHT3x_AbsoluteHumidity(int16_t Temperature, uint16_t Humidity)
+{
+  uint32_t Kelvin = (uint32_t)(SHT3x_SummaryClampTemp(Temperature) + SHT3X_SUMMARY_KELVIN);
+  uint32_t Exp = SHT3x_SummaryExp(SHT3x_SummaryMagnus(Temperature, Humidity));
+
+  return (uint32_t)(((uint64_t)SHT3X_SUMMARY_ABS_HUMIDITY * Exp) /
+                    ((uint64_t)Kelvin << 16));
+}
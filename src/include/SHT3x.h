@@ -43,6 +43,104 @@ extern "C" {
 
 /* Includes ---------------------------------------------------------------------*/
 #include <stdint.h>
+#include <stddef.h>
+
+
+/* Functionality Options --------------------------------------------------------*/
+/**
+ * @brief  Specify the CRC-8 calculation method of the built-in CRC check
+ *         - 0: Bitwise (compact code, no table)
+ *         - 1: Lookup table (fast, needs 256 bytes of constant data)
+ */
+#ifndef SHT3X_CONFIG_CRC_TABLE
+#if defined(__AVR__)
+#define SHT3X_CONFIG_CRC_TABLE  0
+#else
+#define SHT3X_CONFIG_CRC_TABLE  1
+#endif
+#endif
+
+/**
+ * @brief  Specify the sample conversion types
+ *         - SHT3X_CONFIG_FLOAT: Calculate floating point fields of sample
+ *           (TempCelsius, TempFahrenheit, HumidityPercent). If it is 0, these
+ *           fields are removed.
+ *         - SHT3X_CONFIG_FIXED_POINT: Calculate integer fields of sample in
+ *           units of 0.01 (TempCentiCelsius, TempCentiFahrenheit,
+ *           HumCentiPercent) using integer math only.
+ */
+#ifndef SHT3X_CONFIG_FLOAT
+#define SHT3X_CONFIG_FLOAT        1
+#endif
+
+#ifndef SHT3X_CONFIG_FIXED_POINT
+#define SHT3X_CONFIG_FIXED_POINT  0
+#endif
+
+/**
+ * @brief  Specify the conversions that are compiled in. It is a combination of
+ *         SHT3x_Conversion_t flags (0x01: Celsius, 0x02: Fahrenheit,
+ *         0x04: Humidity). Conversions that are not included are never linked.
+ */
+#ifndef SHT3X_CONFIG_CONVERSION
+#define SHT3X_CONFIG_CONVERSION   0x07
+#endif
+
+/**
+ * @brief  Specify whether the driver keeps performance counters in the handler
+ *         (see SHT3x_Stats_t, SHT3x_GetStats() and SHT3x_ResetStats())
+ *         - 0: Disable
+ *         - 1: Enable
+ */
+#ifndef SHT3X_CONFIG_STATS
+#define SHT3X_CONFIG_STATS        0
+#endif
+
+/**
+ * @brief  Specify how the driver calls the platform functions
+ *         - 0: Through the function pointers of handler
+ *         - 1: Directly (compile-time platform for builds with one fixed port).
+ *           The header named by SHT3X_CONFIG_STATIC_PLATFORM_HEADER is included
+ *           by the driver and must define these macros as names of functions
+ *           with the same types as the function pointers of handler:
+ *           - SHT3X_STATIC_SEND, SHT3X_STATIC_RECEIVE, SHT3X_STATIC_DELAY
+ *           - SHT3X_STATIC_INIT, SHT3X_STATIC_DEINIT, SHT3X_STATIC_DELAY_US,
+ *             SHT3X_STATIC_GET_TIME, SHT3X_STATIC_SEND_RECEIVE,
+ *             SHT3X_STATIC_PROBE, SHT3X_STATIC_BUS_RECOVERY,
+ *             SHT3X_STATIC_LOCK and SHT3X_STATIC_UNLOCK (optional)
+ *           Optional functions that are not defined are treated as NULL and
+ *           their code is removed. SHT3x_Init() stores the functions in the
+ *           handler for optional modules. Define the functions as static
+ *           inline in the header (or build with LTO) to inline them.
+ * @note   It must be defined for all source files (e.g. by compiler options).
+ */
+#ifndef SHT3X_CONFIG_STATIC_PLATFORM
+#define SHT3X_CONFIG_STATIC_PLATFORM  0
+#endif
+
+#ifndef SHT3X_CONFIG_STATIC_PLATFORM_HEADER
+#define SHT3X_CONFIG_STATIC_PLATFORM_HEADER  "SHT3x_static.h"
+#endif
+
+/**
+ * @brief  Fix the measurement mode and repeatability at compile time
+ *         - -1: Set at run time (any mode or repeatability)
+ *         - SHT3X_CONFIG_STATIC_MODE: SHT3x_Mode_t value (0 to 2)
+ *         - SHT3X_CONFIG_STATIC_REPEATABILITY: SHT3x_Repeatability_t value
+ *           (0 to 2)
+ * @note   The driver uses them as constants, so the code of other modes is
+ *         removed and the mode functions reject other values with
+ *         SHT3x_INVALID_PARAM. SHT3x_Init() selects Single Shot mode only if
+ *         it is allowed, so call SHT3x_SetModePeriodic() or SHT3x_SetModeART()
+ *         after it in other modes.
+ */
+#ifndef SHT3X_CONFIG_STATIC_MODE
+#define SHT3X_CONFIG_STATIC_MODE            -1
+#endif
+
+#ifndef SHT3X_CONFIG_STATIC_REPEATABILITY
+#define SHT3X_CONFIG_STATIC_REPEATABILITY   -1
+#endif
 
 
 /* Exported Data Types ----------------------------------------------------------*/
@@ -92,16 +190,57 @@ typedef enum SHT3x_Repeatability_e
 } SHT3x_Repeatability_t;
 
 
+/**
+ * @brief  Sample conversion flags
+ * @note   Flags can be combined
+ */
+typedef enum SHT3x_Conversion_e
+{
+  SHT3x_CONVERSION_RAW        = 0x00,
+  SHT3x_CONVERSION_CELSIUS    = 0x01,
+  SHT3x_CONVERSION_FAHRENHEIT = 0x02,
+  SHT3x_CONVERSION_HUMIDITY   = 0x04,
+  SHT3x_CONVERSION_ALL        = 0x07,
+} SHT3x_Conversion_t;
+
+/**
+ * @brief  Status register bits
+ */
+typedef enum SHT3x_StatusFlag_e
+{
+  SHT3x_STATUS_ALERT_PENDING      = 0x8000, // At least one pending alert
+  SHT3x_STATUS_HEATER_ON          = 0x2000, // Heater is ON
+  SHT3x_STATUS_RH_ALERT           = 0x0800, // RH tracking alert
+  SHT3x_STATUS_T_ALERT            = 0x0400, // T tracking alert
+  SHT3x_STATUS_RESET_DETECTED     = 0x0010, // System reset detected
+  SHT3x_STATUS_COMMAND_FAILED     = 0x0002, // Last command not processed
+  SHT3x_STATUS_WRITE_CRC_FAILED   = 0x0001, // Checksum of last write failed
+} SHT3x_StatusFlag_t;
+
+/**
+ * @brief  Alert limits
+ */
+typedef enum SHT3x_AlertLimit_e
+{
+  SHT3x_ALERT_HIGH_SET    = 0,
+  SHT3x_ALERT_HIGH_CLEAR  = 1,
+  SHT3x_ALERT_LOW_CLEAR   = 2,
+  SHT3x_ALERT_LOW_SET     = 3,
+} SHT3x_AlertLimit_t;
+
+
 /**
  * @brief  Function type for Initialize/Deinitialize the platform dependent layer.
+ * @param  Context: User context of the handler
  * @retval 
  *         -  0: The operation was successful.
  *         - -1: The operation failed. 
  */
-typedef int8_t (*SHT3x_PlatformInitDeinit_t)(void);
+typedef int8_t (*SHT3x_PlatformInitDeinit_t)(void *Context);
 
 /**
  * @brief  Function type for Send/Receive data to/from the slave.
+ * @param  Context: User context of the handler
  * @param  Address: Address of slave (0 <= Address <= 127)
  * @param  Data: Pointer to data
  * @param  Len: data len in Bytes
@@ -111,9 +250,62 @@ typedef int8_t (*SHT3x_PlatformInitDeinit_t)(void);
  *         - -2: Bus is busy.
  *         - -3: Slave doesn't ACK the transfer.
  */
-typedef int8_t (*SHT3x_PlatformSendReceive_t)(uint8_t Address,
+typedef int8_t (*SHT3x_PlatformSendReceive_t)(void *Context, uint8_t Address,
                                               uint8_t *Data, uint8_t Len);
 
+/**
+ * @brief  Function type for Send data to the slave and then receive data from
+ *         it in one bus transaction (repeated START between them).
+ * @param  Context: User context of the handler
+ * @param  Address: Address of slave (0 <= Address <= 127)
+ * @param  TxData: Pointer to data to send
+ * @param  TxLen: Send data len in Bytes
+ * @param  RxData: Pointer to received data
+ * @param  RxLen: Receive data len in Bytes
+ * @retval 
+ *         -  0: The operation was successful.
+ *         - -1: Failed to send/receive.
+ *         - -2: Bus is busy.
+ *         - -3: Slave doesn't ACK the read header (no data).
+ */
+typedef int8_t (*SHT3x_PlatformWriteRead_t)(void *Context, uint8_t Address,
+                                            uint8_t *TxData, uint8_t TxLen,
+                                            uint8_t *RxData, uint8_t RxLen);
+
+/**
+ * @brief  Function type for check if a slave acknowledges its address.
+ * @note   It should use a short timeout, so missing devices are reported fast.
+ * @param  Context: User context of the handler
+ * @param  Address: Address of slave (0 <= Address <= 127)
+ * @retval 
+ *         -  0: The address is acknowledged.
+ *         - -1: Failed to access the bus.
+ *         - -3: The address is not acknowledged.
+ */
+typedef int8_t (*SHT3x_PlatformProbe_t)(void *Context, uint8_t Address);
+
+/**
+ * @brief  Function type for recovery of a stuck bus.
+ * @note   It should release a slave that holds SDA low (e.g. 9 clocks on SCL
+ *         followed by a STOP condition) and reinitialize the I2C peripheral.
+ * @param  Context: User context of the handler
+ * @retval 
+ *         -  0: The operation was successful.
+ *         - -1: The operation failed.
+ */
+typedef int8_t (*SHT3x_PlatformBusRecovery_t)(void *Context);
+
+/**
+ * @brief  Function type for lock and unlock of a shared bus.
+ * @note   All handlers on the same bus must use the same lock (e.g. a mutex
+ *         selected by Context). Lock may wait until the bus is free.
+ * @param  Context: User context of the handler
+ * @retval 
+ *         -  0: The operation was successful.
+ *         - -1: The operation failed (e.g. lock timeout).
+ */
+typedef int8_t (*SHT3x_PlatformLock_t)(void *Context);
+
 /**
  * @brief  Function type for check CRC of the data received.
  * @param  Data: 16 bit data received
@@ -126,12 +318,108 @@ typedef int8_t (*SHT3x_PlatformCRC_t)(uint16_t Data, uint8_t DataCRC);
 
 /**
  * @brief  Function type for delay in ms.
+ * @param  Context: User context of the handler
  * @param  Delay: Delay duration in ms
  * @retval 
  *         -  0: The operation was successful.
  *         - -1: The operation failed.
  */
-typedef int8_t (*SHT3x_PlatformDelay_t)(uint8_t Delay);
+typedef int8_t (*SHT3x_PlatformDelay_t)(void *Context, uint8_t Delay);
+
+/**
+ * @brief  Function type for delay in us.
+ * @note   The function must wait at least Delay. Short delays may be a busy
+ *         wait.
+ * @param  Context: User context of the handler
+ * @param  Delay: Delay duration in us
+ * @retval 
+ *         -  0: The operation was successful.
+ *         - -1: The operation failed.
+ */
+typedef int8_t (*SHT3x_PlatformDelayUs_t)(void *Context, uint32_t Delay);
+
+/**
+ * @brief  Function type for get the current time in us.
+ * @note   The returned value must be monotonic. It is allowed to wrap around.
+ * @param  Context: User context of the handler
+ * @retval Current time in us
+ */
+typedef uint32_t (*SHT3x_PlatformGetTime_t)(void *Context);
+
+/**
+ * @brief  Function type for completion of an asynchronous transfer.
+ * @note   The platform layer calls it (usually from an interrupt) when the
+ *         transfer is finished.
+ * @param  Arg: Argument passed to PlatformTransferAsync
+ * @param  Result: 
+ *         -  0: The transfer was successful.
+ *         - -1: Failed to send/receive.
+ *         - -2: Bus is busy.
+ *         - -3: Slave doesn't ACK the transfer.
+ */
+typedef void (*SHT3x_TransferDone_t)(void *Arg, int8_t Result);
+
+/**
+ * @brief  Function type for start an asynchronous transfer to/from the slave.
+ * @note   If the transfer is started, Done must be called exactly once when
+ *         it is finished.
+ * @param  Context: User context of the handler
+ * @param  Address: Address of slave (0 <= Address <= 127)
+ * @param  Data: Pointer to data. It is valid until the transfer is finished.
+ * @param  Len: data len in Bytes
+ * @param  Read: 
+ *         - 0: Send data to the slave
+ *         - 1: Receive data from the slave
+ * @param  Done: Completion function
+ * @param  Arg: Argument of Done
+ * @retval 
+ *         -  0: The transfer is started.
+ *         - -1: Failed to start the transfer.
+ *         - -2: Bus is busy.
+ */
+typedef int8_t (*SHT3x_PlatformTransferAsync_t)(void *Context, uint8_t Address,
+                                                uint8_t *Data, uint8_t Len,
+                                                uint8_t Read,
+                                                SHT3x_TransferDone_t Done,
+                                                void *Arg);
+
+#if (SHT3X_CONFIG_STATS == 1)
+/**
+ * @brief  Performance counters data type
+ * @note   Latency fields are in us and cover SHT3x_ReadSample() calls that
+ *         returned SHT3x_OK. They are valid only if PlatformGetTime has been
+ *         set since the last reset.
+ */
+typedef struct SHT3x_Stats_s
+{
+  uint32_t Transactions;  // Bus transactions (a combined write/read is one)
+  uint32_t Bytes;         // Bytes sent and received
+  uint32_t Nacks;         // Transactions not acknowledged by the sensor
+  uint32_t BusErrors;     // Other failed transactions
+  uint32_t NoData;        // Fetches that returned SHT3x_NO_DATA
+  uint32_t CRCErrors;     // Received words with CRC error
+  uint32_t PollRetries;   // Fetch retries of Single Shot mode polling
+  uint32_t Reads;         // Successful SHT3x_ReadSample() calls
+  uint32_t Recoveries;    // Bus recoveries
+  uint32_t Rejected;      // Transfers rejected by the open circuit breaker
+  uint32_t LatencyMin;
+  uint32_t LatencyMax;
+  uint32_t LatencyAvg;    // Calculated by SHT3x_GetStats()
+  uint64_t LatencyTotal;
+} SHT3x_Stats_t;
+#endif
+
+struct SHT3x_Handler_s;
+
+/**
+ * @brief  Function type for completion of SHT3x_ReadSampleAsync().
+ * @note   It is called in the context of the platform completion function
+ *         (usually an interrupt).
+ * @param  Handler: Pointer to handler
+ * @param  Result: Result of reading (same as SHT3x_ReadSample())
+ */
+typedef void (*SHT3x_AsyncCallback_t)(struct SHT3x_Handler_s *Handler,
+                                      SHT3x_Result_t Result);
 
 /**
  * @brief  Handler data type
@@ -140,9 +428,21 @@ typedef int8_t (*SHT3x_PlatformDelay_t)(uint8_t Delay);
  *         - PlatformDeInit
  *         - PlatformSend
  *         - PlatformReceive
- *         - PlatformCRC
+ *         - PlatformCRC (optional)
  *         - PlatformDelay
+ *         - PlatformDelayUs (optional)
+ *         - PlatformGetTime (optional)
+ *         - PlatformTransferAsync (optional)
+ *         - PlatformSendReceive (optional)
+ *         - PlatformProbe (optional)
+ *         - PlatformBusRecovery (optional)
+ *         - PlatformLock and PlatformUnlock (optional)
  * @note   If success the functions must return 0 
+ * @note   Context is passed to all platform functions (except PlatformCRC). It
+ *         can be used to select the bus of the sensor, so one set of platform
+ *         functions can handle any number of buses and sensors.
+ * @note   If SHT3X_CONFIG_STATIC_PLATFORM is 1, the function pointers (except
+ *         PlatformCRC and PlatformTransferAsync) are set by SHT3x_Init().
  */
 typedef struct SHT3x_Handler_s
 {
@@ -150,6 +450,11 @@ typedef struct SHT3x_Handler_s
   SHT3x_Mode_t Mode;
   SHT3x_Repeatability_t Repeatability;
   SHT3x_Speed_t Speed;
+  uint8_t ClockStretching;
+  uint8_t Conversion;
+
+  // User context passed to platform dependent functions
+  void *Context;
 
   // Initializes platform dependent layer
   SHT3x_PlatformInitDeinit_t PlatformInit;
@@ -161,9 +466,63 @@ typedef struct SHT3x_Handler_s
   SHT3x_PlatformSendReceive_t PlatformReceive;
   // Delay in ms
   SHT3x_PlatformDelay_t PlatformDelay;
-  // Check CRC of Data (If you do not want to check CRC, this function must
-  // allways return 0)
+  // Check CRC of Data (optional). If it is NULL, the built-in CRC-8 check is
+  // used. If you do not want to check CRC, this function must allways return 0.
   SHT3x_PlatformCRC_t PlatformCRC;
+  // Delay in us (optional). If it is set, it is used instead of PlatformDelay
+  // and waits are not rounded up to whole ms.
+  SHT3x_PlatformDelayUs_t PlatformDelayUs;
+  // Get current time in us (optional). It is used to find out when a single
+  // shot measurement is finished without polling the bus.
+  SHT3x_PlatformGetTime_t PlatformGetTime;
+  // Start an interrupt/DMA driven transfer (optional). It is needed only by
+  // SHT3x_ReadSampleAsync().
+  SHT3x_PlatformTransferAsync_t PlatformTransferAsync;
+  // Send a command and receive the response in one transaction (optional).
+  // It is used for fetch and status read. If it is NULL, PlatformSend and
+  // PlatformReceive are used.
+  SHT3x_PlatformWriteRead_t PlatformSendReceive;
+  // Check if a slave acknowledges its address (optional). It is used by
+  // SHT3x_Discover() before reading the status register.
+  SHT3x_PlatformProbe_t PlatformProbe;
+  // Recover a stuck bus (optional). It is called by the circuit breaker (see
+  // SHT3x_SetFailPolicy()) and by SHT3x_RecoverBus().
+  SHT3x_PlatformBusRecovery_t PlatformBusRecovery;
+  // Lock and unlock the bus (optional). The lock is held across each command
+  // and response sequence, so handlers of several tasks can share a bus.
+  // Transfers of SHT3x_ReadSampleAsync() are not locked.
+  SHT3x_PlatformLock_t PlatformLock;
+  SHT3x_PlatformLock_t PlatformUnlock;
+
+  // Private data. Do not change them.
+  uint8_t Command[2]; // Measurement or fetch command of the current mode
+  uint8_t MeasurementPending;
+  uint32_t MeasurementDeadline;
+  uint8_t FetchWait;
+  uint8_t SampleLate;
+  uint32_t SamplePeriod; // Periodic/ART sample period in us
+  uint32_t PeriodicStart;
+  uint32_t LastFetch;
+  uint32_t SampleDue;
+  uint16_t Status;           // Last known status register
+  uint8_t StatusValid;
+  uint16_t StatusRefreshEvery;
+  uint16_t StatusSamples;
+  volatile uint8_t AsyncState;
+  uint8_t AsyncBuffer[6];
+  struct SHT3x_Sample_s *AsyncSample;
+  SHT3x_AsyncCallback_t AsyncCallback;
+  uint8_t FailLimit;
+  uint8_t FailCount;
+  uint8_t BreakerOpen;
+  uint32_t BackoffMin;       // in ms
+  uint32_t BackoffMax;       // in ms
+  uint32_t Backoff;          // in ms
+  uint32_t BreakerRetry;
+  uint8_t LockHeld;          // Lock depth (see SHT3x_SetLockHeld())
+#if (SHT3X_CONFIG_STATS == 1)
+  SHT3x_Stats_t Stats;
+#endif
 } SHT3x_Handler_t;
 
 /**
@@ -173,9 +532,16 @@ typedef struct SHT3x_Sample_s
 {
   uint16_t  TempRaw;
   uint16_t  HumRaw;
+#if (SHT3X_CONFIG_FLOAT == 1)
   float     TempCelsius;
   float     TempFahrenheit;
   float     HumidityPercent;
+#endif
+#if (SHT3X_CONFIG_FIXED_POINT == 1)
+  int16_t   TempCentiCelsius;     // Temperature in 0.01 C
+  int16_t   TempCentiFahrenheit;  // Temperature in 0.01 F
+  uint16_t  HumCentiPercent;      // Relative humidity in 0.01 %
+#endif
 } SHT3x_Sample_t;
 
 
@@ -226,15 +592,74 @@ SHT3x_SetModePeriodic(SHT3x_Handler_t *Handler,
  * @retval SHT3x_Result_t
  *         - SHT3x_OK: Operation was successful.
  *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_INVALID_PARAM: ART mode is not allowed by
+ *           SHT3X_CONFIG_STATIC_MODE.
  */
 SHT3x_Result_t
 SHT3x_SetModeART(SHT3x_Handler_t *Handler);
 
 
+/**
+ * @brief  Enable or disable clock stretching in Single Shot mode
+ * @note   When clock stretching is enabled, the sensor holds SCL low until the
+ *         measurement is finished. So SHT3x_ReadSample() uses a single read
+ *         transaction instead of polling. The platform layer must support
+ *         clock stretching for up to 15ms.
+ *
+ * @param  Handler: Pointer to handler
+ * @param  ClockStretching: 
+ *         - 0: Disable clock stretching
+ *         - 1: Enable clock stretching
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ */
+SHT3x_Result_t
+SHT3x_SetClockStretching(SHT3x_Handler_t *Handler, uint8_t ClockStretching);
+
+
+/**
+ * @brief  Enable or disable waiting for the next sample in Periodic and ART
+ *         mode
+ * @note   When it is enabled and PlatformGetTime is set, SHT3x_ReadSample()
+ *         waits until SHT3x_NextSampleDueIn() elapses before touching the
+ *         bus, so fetches are not wasted on NO_DATA responses.
+ *
+ * @param  Handler: Pointer to handler
+ * @param  FetchWait: 
+ *         - 0: Fetch immediately (SHT3x_NO_DATA if no new sample is ready)
+ *         - 1: Wait for the next sample
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ */
+SHT3x_Result_t
+SHT3x_SetFetchWait(SHT3x_Handler_t *Handler, uint8_t FetchWait);
+
+
+/**
+ * @brief  Select the conversions done by SHT3x_ReadSample() and
+ *         SHT3x_FetchSample()
+ * @note   SHT3x_Init() selects SHT3x_CONVERSION_ALL. Use SHT3x_CONVERSION_RAW
+ *         to fill only the raw fields and convert later by
+ *         SHT3x_ConvertSample().
+ *
+ * @param  Handler: Pointer to handler
+ * @param  Conversion: Combination of SHT3x_Conversion_t flags
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_SetConversion(SHT3x_Handler_t *Handler, uint8_t Conversion);
+
+
 /**
  * @brief  Read a sample
  * @note   In Single Shot mode, the function starts measuring and waits up to
- *         20ms to finish.
+ *         20ms to finish. If clock stretching is enabled, the sensor holds
+ *         the bus until the measurement is finished.
  *
  * @param  Handler: Pointer to handler
  * @param  Sample: Pointer to sample buffer
@@ -248,6 +673,166 @@ SHT3x_Result_t
 SHT3x_ReadSample(SHT3x_Handler_t *Handler, SHT3x_Sample_t *Sample);
 
 
+/**
+ * @brief  Start a measurement in Single Shot mode and return immediately
+ * @note   Use SHT3x_IsReady() and SHT3x_FetchSample() to get the result.
+ *
+ * @param  Handler: Pointer to handler
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_INVALID_PARAM: Mode is not Single Shot.
+ */
+SHT3x_Result_t
+SHT3x_StartMeasurement(SHT3x_Handler_t *Handler);
+
+
+/**
+ * @brief  Check if the measurement started by SHT3x_StartMeasurement() is
+ *         finished
+ * @note   This function never accesses the bus. If PlatformGetTime is not
+ *         set, the driver can not track the conversion time and this
+ *         function always reports ready.
+ *
+ * @param  Handler: Pointer to handler
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Measurement is finished.
+ *         - SHT3x_NO_DATA: Measurement is still in progress.
+ *         - SHT3x_INVALID_PARAM: No measurement is in progress.
+ */
+SHT3x_Result_t
+SHT3x_IsReady(SHT3x_Handler_t *Handler);
+
+
+/**
+ * @brief  Abandon the measurement started by SHT3x_StartMeasurement()
+ * @note   Use it when the result is no longer needed (e.g. the sensor did not
+ *         finish in time). The bus is not accessed.
+ *
+ * @param  Handler: Pointer to handler
+ * @retval None
+ */
+void
+SHT3x_CancelMeasurement(SHT3x_Handler_t *Handler);
+
+
+/**
+ * @brief  Fetch the result of a measurement
+ * @note   In Single Shot mode, the measurement must be started by
+ *         SHT3x_StartMeasurement(). If PlatformGetTime is set and the
+ *         conversion is not finished yet, the bus is not accessed.
+ *         Otherwise, with clock stretching enabled, the sensor holds the bus
+ *         until the measurement is finished.
+ * @note   In Periodic and ART modes, this function is the same as
+ *         SHT3x_ReadSample().
+ *
+ * @param  Handler: Pointer to handler
+ * @param  Sample: Pointer to sample buffer
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_INVALID_PARAM: No measurement is in progress.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ *         - SHT3x_NO_DATA: No measurement data is present.
+ */
+SHT3x_Result_t
+SHT3x_FetchSample(SHT3x_Handler_t *Handler, SHT3x_Sample_t *Sample);
+
+
+/**
+ * @brief  Read a sample using interrupt/DMA driven transfers
+ * @note   The function starts the transfer and returns immediately. Callback
+ *         is called when reading is finished. Sample must stay valid until
+ *         then.
+ * @note   In Single Shot mode, the measurement must be started by
+ *         SHT3x_StartMeasurement() before. If it is not finished yet, the
+ *         function returns SHT3x_NO_DATA and the bus is not accessed.
+ * @note   Conversion of the sample is done in the completion context. Use
+ *         SHT3x_SetConversion() to keep it short.
+ *
+ * @param  Handler: Pointer to handler
+ * @param  Sample: Pointer to sample buffer
+ * @param  Callback: Completion function (optional)
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Reading is started.
+ *         - SHT3x_FAIL: Failed to start the transfer or another asynchronous
+ *                       reading is in progress.
+ *         - SHT3x_INVALID_PARAM: PlatformTransferAsync is not set or no
+ *                                measurement is in progress.
+ *         - SHT3x_NO_DATA: Measurement is still in progress.
+ */
+SHT3x_Result_t
+SHT3x_ReadSampleAsync(SHT3x_Handler_t *Handler, SHT3x_Sample_t *Sample,
+                      SHT3x_AsyncCallback_t Callback);
+
+
+/**
+ * @brief  Check if an asynchronous reading is in progress
+ * @param  Handler: Pointer to handler
+ * @retval 
+ *         - 0: No asynchronous reading is in progress.
+ *         - 1: Asynchronous reading is in progress.
+ */
+uint8_t
+SHT3x_IsAsyncBusy(SHT3x_Handler_t *Handler);
+
+
+/**
+ * @brief  Get the maximum measurement duration in Single Shot mode
+ * @param  Repeatability: Specify repeatability level
+ * @retval Measurement duration in us (0 if Repeatability is not valid)
+ */
+uint32_t
+SHT3x_GetMeasurementTime(SHT3x_Repeatability_t Repeatability);
+
+
+/**
+ * @brief  Get the time until the next sample is expected to be ready
+ * @note   In Periodic and ART mode, the first sample is expected one
+ *         measurement time after the mode is started and next ones are
+ *         expected on a grid of sample periods. The grid is moved to the last
+ *         successful fetch when a sample arrives earlier or later than
+ *         expected. A late sample is expected again after 1/64 of the sample
+ *         period. In Single Shot mode, it is the time until the pending
+ *         measurement is finished.
+ * @note   The function never accesses the bus. If PlatformGetTime is not set
+ *         or no measurement is expected, it returns 0.
+ *
+ * @param  Handler: Pointer to handler
+ * @retval Time until the next sample in us
+ */
+uint32_t
+SHT3x_NextSampleDueIn(SHT3x_Handler_t *Handler);
+
+
+/**
+ * @brief  Get the time until the pending Single Shot measurement is expected
+ *         to be finished
+ * @note   If PlatformGetTime is set, it is SHT3x_NextSampleDueIn(). Else the
+ *         elapsed time is unknown and the maximum measurement time of the
+ *         current repeatability is returned.
+ * @note   The function never accesses the bus.
+ *
+ * @param  Handler: Pointer to handler
+ * @retval Time in us (0 if no Single Shot measurement is pending)
+ */
+uint32_t
+SHT3x_MeasurementDueIn(SHT3x_Handler_t *Handler);
+
+
+/**
+ * @brief  Wait until the pending Single Shot measurement is expected to be
+ *         finished
+ * @note   It waits SHT3x_MeasurementDueIn() at once by PlatformDelayUs if it
+ *         is set, else by PlatformDelay (rounded up to ms).
+ *
+ * @param  Handler: Pointer to handler
+ * @retval Waited time in us
+ */
+uint32_t
+SHT3x_WaitMeasurement(SHT3x_Handler_t *Handler);
+
+
 
 /**
  ==================================================================================
@@ -272,6 +857,66 @@ SHT3x_Result_t
 SHT3x_Init(SHT3x_Handler_t *Handler, uint8_t Address);
 
 
+/**
+ * @brief  Initialize several sensors at once
+ * @note   Stop and reset commands are sent to all sensors first, then the
+ *         function waits once for the reset and checks each sensor by reading
+ *         its status register (the reset bit must be set).
+ * @note   With GeneralCall, one general call reset is sent on each bus (each
+ *         distinct Context) instead of a soft reset per sensor. It resets all
+ *         devices on the bus that support the general call, not only the
+ *         SHT3x sensors. If the general call is not acknowledged, soft reset
+ *         is used for the sensors of that bus.
+ *
+ * @param  Handlers: Pointer to array of handlers (Count items)
+ * @param  Addresses: Pointer to array of addresses (Count items). See
+ *                    SHT3x_Init().
+ * @param  Count: Number of handlers
+ * @param  GeneralCall: 1 to use the I2C general call reset, 0 to use soft
+ *                      reset
+ * @param  Results: Pointer to array of results of each sensor (Count items)
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: All sensors are initialized successfully.
+ *         - SHT3x_FAIL: Initializing of at least one sensor failed.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_InitMany(SHT3x_Handler_t *Handlers, const uint8_t *Addresses,
+               uint8_t Count, uint8_t GeneralCall, SHT3x_Result_t *Results);
+
+
+/**
+ * @brief  Find the sensors on the buses
+ * @note   Both addresses are checked on each bus by PlatformProbe (if it is
+ *         set) and a status register read. A handler is filled for each
+ *         sensor found: it is a copy of the bus handler with the address of
+ *         the sensor, initialized in Single Shot mode without reset. Use
+ *         SHT3x_DeInit() to release it.
+ * @note   Each filled handler holds one PlatformInit call and the other
+ *         calls (at most one per bus at a time) are released by
+ *         PlatformDeInit before returning. If several sensors share a bus,
+ *         the port must count PlatformInit and PlatformDeInit calls and
+ *         release the bus on the last one.
+ *
+ * @param  Buses: Pointer to array of bus handlers (BusCount items). Only
+ *                platform functions and Context are used.
+ * @param  BusCount: Number of buses
+ * @param  Handlers: Pointer to array of handlers to fill (MaxHandlers items)
+ * @param  MaxHandlers: Maximum number of handlers
+ * @param  Found: Pointer to number of sensors found
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: All buses are checked.
+ *         - SHT3x_FAIL: Initializing of at least one bus failed or a sensor
+ *                       was found when Handlers was full.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_Discover(const SHT3x_Handler_t *Buses, uint8_t BusCount,
+               SHT3x_Handler_t *Handlers, uint8_t MaxHandlers, uint8_t *Found);
+
+
 /**
  * @brief  Deinitialize function
  * @param  Handler: Pointer to handler
@@ -337,6 +982,245 @@ SHT3x_Result_t
 SHT3x_SetHeater(SHT3x_Handler_t *Handler, uint8_t Heater);
 
 
+/**
+ * @brief  Get the status register with the cache policy
+ * @note   The last status word is cached in the handler. SHT3x_ReadStatus(),
+ *         SHT3x_ClearStatus() and SHT3x_SetHeater() keep the cache up to
+ *         date. The status register is read from the bus only if the cache is
+ *         not valid: after SHT3x_Init(), after a bus or CRC error, or after
+ *         the number of samples set by SHT3x_SetStatusRefresh().
+ *
+ * @param  Handler: Pointer to handler
+ * @param  Status: pointer to status register 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ */
+SHT3x_Result_t
+SHT3x_GetStatus(SHT3x_Handler_t *Handler, uint16_t *Status);
+
+
+/**
+ * @brief  Check a flag of the status register with the cache policy
+ * @note   See SHT3x_GetStatus().
+ * @param  Handler: Pointer to handler
+ * @param  Flag: One of SHT3x_StatusFlag_t
+ * @param  Set: Pointer to result (1 if the flag is set, 0 otherwise)
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ */
+SHT3x_Result_t
+SHT3x_GetStatusFlag(SHT3x_Handler_t *Handler, SHT3x_StatusFlag_t Flag,
+                    uint8_t *Set);
+
+
+/**
+ * @brief  Set the refresh policy of the cached status register
+ * @param  Handler: Pointer to handler
+ * @param  Every: The cache is invalidated after this number of samples
+ *                (0: only on error)
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ */
+SHT3x_Result_t
+SHT3x_SetStatusRefresh(SHT3x_Handler_t *Handler, uint16_t Every);
+
+
+/**
+ * @brief  Write an alert limit
+ * @note   The ALERT pin and the alert bits of the status register are
+ *         driven in Periodic and ART mode. The limit is stored with the
+ *         resolution of the sensor format (7 MSBs of RH and 9 MSBs of T).
+ *
+ * @param  Handler: Pointer to handler
+ * @param  Limit: Specify the alert limit
+ * @param  TempCentiCelsius: Temperature limit in 0.01 C (-4500 to 13000)
+ * @param  HumCentiPercent: Relative humidity limit in 0.01 % (0 to 10000)
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_WriteAlertLimit(SHT3x_Handler_t *Handler, SHT3x_AlertLimit_t Limit,
+                      int16_t TempCentiCelsius, uint16_t HumCentiPercent);
+
+
+/**
+ * @brief  Read back an alert limit
+ * @param  Handler: Pointer to handler
+ * @param  Limit: Specify the alert limit
+ * @param  TempCentiCelsius: Pointer to temperature limit in 0.01 C
+ * @param  HumCentiPercent: Pointer to relative humidity limit in 0.01 %
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_ReadAlertLimit(SHT3x_Handler_t *Handler, SHT3x_AlertLimit_t Limit,
+                     int16_t *TempCentiCelsius, uint16_t *HumCentiPercent);
+
+
+/**
+ * @brief  Set the failure policy (bus recovery and circuit breaker)
+ * @note   After FailLimit consecutive failed transfers, PlatformBusRecovery is
+ *         called (if it is set) and the circuit breaker is opened: transfers
+ *         of this handler fail at once without accessing the bus for the
+ *         backoff time. Then transfers are allowed again. A failure at this
+ *         point opens the breaker again with twice the backoff (up to
+ *         BackoffMax). A successful transfer closes the breaker and resets
+ *         the backoff to BackoffMin.
+ * @note   A NACK of a read header is not a failure, because the sensor does
+ *         it while it is measuring. SHT3x_ReadSampleAsync() transfers are not
+ *         covered.
+ * @note   The breaker needs PlatformGetTime. Without it, only the bus
+ *         recovery is done.
+ *
+ * @param  Handler: Pointer to handler
+ * @param  FailLimit: Number of consecutive failures (0: disable)
+ * @param  BackoffMin: First backoff time in ms (0: no breaker)
+ * @param  BackoffMax: Maximum backoff time in ms
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_SetFailPolicy(SHT3x_Handler_t *Handler, uint8_t FailLimit,
+                    uint32_t BackoffMin, uint32_t BackoffMax);
+
+
+/**
+ * @brief  Check if the circuit breaker of the handler is open
+ * @param  Handler: Pointer to handler
+ * @retval 1 if transfers are rejected now, 0 otherwise
+ */
+uint8_t
+SHT3x_IsBreakerOpen(SHT3x_Handler_t *Handler);
+
+
+/**
+ * @brief  Recover the bus of the handler and close its circuit breaker
+ * @param  Handler: Pointer to handler
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to recover the bus.
+ *         - SHT3x_INVALID_PARAM: PlatformBusRecovery is not set.
+ */
+SHT3x_Result_t
+SHT3x_RecoverBus(SHT3x_Handler_t *Handler);
+
+
+/**
+ * @brief  Tell the driver that the caller holds the bus lock
+ * @note   While it is set, the driver does not call PlatformLock and
+ *         PlatformUnlock of the handler. So the caller can run several
+ *         functions, or functions of several handlers on the same bus, under
+ *         one lock hold. Do not change it while a function of the handler is
+ *         running.
+ *
+ * @param  Handler: Pointer to handler
+ * @param  Held:
+ *         - 0: The caller does not hold the lock
+ *         - 1: The caller holds the lock
+ * 
+ * @retval None
+ */
+void
+SHT3x_SetLockHeld(SHT3x_Handler_t *Handler, uint8_t Held);
+
+
+
+#if (SHT3X_CONFIG_STATS == 1)
+/**
+ ==================================================================================
+                         ##### Statistics Functions #####                          
+ ==================================================================================
+ */
+
+/**
+ * @brief  Take a snapshot of the performance counters
+ * @note   Counters updated from interrupt context (asynchronous reading) may
+ *         be out of date by one update.
+ *
+ * @param  Handler: Pointer to handler
+ * @param  Stats: Pointer to the snapshot
+ * @retval None
+ */
+void
+SHT3x_GetStats(SHT3x_Handler_t *Handler, SHT3x_Stats_t *Stats);
+
+
+/**
+ * @brief  Reset the performance counters
+ * @param  Handler: Pointer to handler
+ * @retval None
+ */
+void
+SHT3x_ResetStats(SHT3x_Handler_t *Handler);
+#endif
+
+
+
+/**
+ ==================================================================================
+                           ##### Utility Functions #####                           
+ ==================================================================================
+ */
+
+/**
+ * @brief  Convert raw values of a sample
+ * @note   Only conversions included in SHT3X_CONFIG_CONVERSION are done.
+ * @param  Sample: Pointer to sample. TempRaw and HumRaw must be valid.
+ * @param  Conversion: Combination of SHT3x_Conversion_t flags
+ * @retval None
+ */
+void
+SHT3x_ConvertSample(SHT3x_Sample_t *Sample, uint8_t Conversion);
+
+
+#if (SHT3X_CONFIG_FLOAT == 1)
+/**
+ * @brief  Convert an array of raw values (structure of arrays layout)
+ * @note   The loop is written so compilers can vectorize it. Raw and Out
+ *         must not overlap.
+ * @param  Raw: Pointer to array of raw values (TempRaw or HumRaw)
+ * @param  Out: Pointer to output array
+ * @param  Len: Number of items
+ * @param  Conversion: One of these flags:
+ *         - SHT3x_CONVERSION_CELSIUS: Raw contains TempRaw values
+ *         - SHT3x_CONVERSION_FAHRENHEIT: Raw contains TempRaw values
+ *         - SHT3x_CONVERSION_HUMIDITY: Raw contains HumRaw values
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_ConvertBatch(const uint16_t *Raw, float *Out, size_t Len,
+                   SHT3x_Conversion_t Conversion);
+#endif
+
+
+/**
+ * @brief  Calculate CRC-8 of data the same way the sensor does
+ *         (Polynomial: 0x31, Initialization: 0xFF)
+ * @param  Data: Pointer to data
+ * @param  Len: data len in Bytes
+ * @retval CRC of data
+ */
+uint8_t
+SHT3x_CalcCRC(const uint8_t *Data, uint8_t Len);
+
+
 
 #ifdef __cplusplus
 }
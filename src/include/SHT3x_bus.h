@@ -0,0 +1,204 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_bus.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Shared bus manager for several SHT3x handlers
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef	_SHT3X_BUS_H_
+#define _SHT3X_BUS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "SHT3x.h"
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Bus request operations
+ * @note   SHT3x_BUS_READ_SAMPLE in single shot mode holds the bus until the
+ *         conversion is done. Use SHT3x_BUS_START_MEASUREMENT and then
+ *         SHT3x_BUS_FETCH_SAMPLE to let other requests use the bus meanwhile.
+ */
+typedef enum SHT3x_BusOperation_e
+{
+  SHT3x_BUS_READ_SAMPLE       = 0,  // SHT3x_ReadSample(), Data: SHT3x_Sample_t
+  SHT3x_BUS_FETCH_SAMPLE      = 1,  // SHT3x_FetchSample(), Data: SHT3x_Sample_t
+  SHT3x_BUS_START_MEASUREMENT = 2,  // SHT3x_StartMeasurement(), Data: unused
+  SHT3x_BUS_READ_STATUS       = 3,  // SHT3x_ReadStatus(), Data: uint16_t
+} SHT3x_BusOperation_t;
+
+struct SHT3x_BusRequest_s;
+
+/**
+ * @brief  Function type for request completion callback
+ * @note   It is called with the bus lock held, so it must be short and must
+ *         not submit and process requests of the same bus.
+ *
+ * @param  Request: Pointer to the completed request
+ * 
+ * @retval None
+ */
+typedef void (*SHT3x_BusCallback_t)(struct SHT3x_BusRequest_s *Request);
+
+/**
+ * @brief  Function type for enter and exit of the queue critical section
+ * @param  Context: Bus context
+ * @retval None
+ */
+typedef void (*SHT3x_BusCritical_t)(void *Context);
+
+/**
+ * @brief  Bus request data type
+ * @note   The request must not be changed until Done is set.
+ */
+typedef struct SHT3x_BusRequest_s
+{
+  SHT3x_Handler_t *Handler;
+  SHT3x_BusOperation_t Operation;
+  void *Data;                    // Result of the operation (see above)
+  SHT3x_BusCallback_t Callback;  // Completion callback (optional)
+  void *Arg;                     // User argument of the callback
+
+  volatile SHT3x_Result_t Result;  // Result of the operation
+  volatile uint8_t Done;           // Set after the callback is returned
+
+  // Private data. Do not change them.
+  struct SHT3x_BusRequest_s *Next;
+} SHT3x_BusRequest_t;
+
+/**
+ * @brief  Shared bus data type
+ * @note   Lock and Unlock are the bus lock (usually the same functions as
+ *         PlatformLock and PlatformUnlock of the handlers). Enter and Exit
+ *         protect the request queue (e.g. disable and enable interrupts or a
+ *         short mutex). All of them are optional in a single task system.
+ *         Lock is required if several tasks call SHT3x_BusTransfer().
+ */
+typedef struct SHT3x_Bus_s
+{
+  void *Context;
+  SHT3x_PlatformLock_t Lock;
+  SHT3x_PlatformLock_t Unlock;
+  SHT3x_BusCritical_t Enter;
+  SHT3x_BusCritical_t Exit;
+
+  // Private data. Do not change them.
+  SHT3x_BusRequest_t *Head;
+  SHT3x_BusRequest_t *Tail;
+} SHT3x_Bus_t;
+
+
+
+/**
+ ==================================================================================
+                             ##### Bus Functions #####                             
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the shared bus
+ * @note   Set Context, Lock, Unlock, Enter and Exit before calling this
+ *         function.
+ *
+ * @param  Bus: Pointer to bus
+ * 
+ * @retval None
+ */
+void
+SHT3x_BusInit(SHT3x_Bus_t *Bus);
+
+
+/**
+ * @brief  Add a request to the queue of the bus
+ * @note   Handler, Operation and Data of the request must be set. The request
+ *         runs on the next call of SHT3x_BusProcess().
+ * @note   It can be called from any task or interrupt if Enter and Exit are
+ *         set.
+ *
+ * @param  Bus: Pointer to bus
+ * @param  Request: Pointer to request
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_BusSubmit(SHT3x_Bus_t *Bus, SHT3x_BusRequest_t *Request);
+
+
+/**
+ * @brief  Run all queued requests back-to-back under one bus lock hold
+ * @note   While a request runs, the lock of its handler is marked as held (see
+ *         SHT3x_SetLockHeld()), so the driver does not take it again.
+ * @note   Requests submitted while the queue runs are left for the next call.
+ *
+ * @param  Bus: Pointer to bus
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: The queued requests are done (see Result of each one).
+ *         - SHT3x_NO_DATA: The queue is empty.
+ *         - SHT3x_FAIL: Failed to take the bus lock. Queue is not changed.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_BusProcess(SHT3x_Bus_t *Bus);
+
+
+/**
+ * @brief  Submit a request and process the queue of the bus
+ * @note   Requests of other handlers in the queue run in the same lock hold.
+ * @note   Lock of the bus must be set if more than one task calls this
+ *         function. If another task has already taken the request from the
+ *         queue, this function waits until it is done and never returns
+ *         while the request is in use.
+ *
+ * @param  Bus: Pointer to bus
+ * @param  Request: Pointer to request
+ * 
+ * @retval SHT3x_Result_t
+ *         - Result of the request if it is done.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ *         - SHT3x_FAIL: Failed to take the bus lock before any task took the
+ *           request. The request is removed from the queue.
+ */
+SHT3x_Result_t
+SHT3x_BusTransfer(SHT3x_Bus_t *Bus, SHT3x_BusRequest_t *Request);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _SHT3X_BUS_H_
@@ -0,0 +1,141 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_group.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  SHT3x multi-sensor group handling
+ *         Functionalities of the this file:
+ *          + Start Single Shot measurements of several sensors back-to-back
+ *          + Collect the results as each measurement finishes
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef	_SHT3X_GROUP_H_
+#define _SHT3X_GROUP_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "SHT3x.h"
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Group data type
+ * @note   All handlers of the group must be initialized and set to Single Shot
+ *         mode before using the group.
+ */
+typedef struct SHT3x_Group_s
+{
+  SHT3x_Handler_t *Handlers;
+  uint8_t Count;
+} SHT3x_Group_t;
+
+
+
+/**
+ ==================================================================================
+                            ##### Group Functions #####                            
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize a group over an array of handlers
+ * @param  Group: Pointer to group
+ * @param  Handlers: Pointer to array of handlers
+ * @param  Count: Number of handlers
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_GroupInit(SHT3x_Group_t *Group, SHT3x_Handler_t *Handlers, uint8_t Count);
+
+
+/**
+ * @brief  Start the measurement of all sensors back-to-back
+ * @param  Group: Pointer to group
+ * @param  Results: Pointer to array of results (Count items). Result of
+ *                  starting the measurement of each sensor is stored here.
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Measurement of all sensors started.
+ *         - SHT3x_FAIL: Failed to start the measurement of at least one sensor.
+ */
+SHT3x_Result_t
+SHT3x_GroupStart(SHT3x_Group_t *Group, SHT3x_Result_t *Results);
+
+
+/**
+ * @brief  Collect the samples of the sensors that finished measuring
+ * @note   This function never waits. The sensors are visited in order and each
+ *         one is fetched only when its measurement is finished.
+ *
+ * @param  Group: Pointer to group
+ * @param  Samples: Pointer to array of samples (Count items)
+ * @param  Results: Pointer to array of results (Count items). It must be the
+ *                  same array passed to SHT3x_GroupStart().
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: All measurements are finished (see Results for the
+ *                     result of each sensor).
+ *         - SHT3x_NO_DATA: At least one measurement is still in progress.
+ */
+SHT3x_Result_t
+SHT3x_GroupCollect(SHT3x_Group_t *Group,
+                   SHT3x_Sample_t *Samples, SHT3x_Result_t *Results);
+
+
+/**
+ * @brief  Read a sample from all sensors
+ * @note   Measurements are started back-to-back and then collected, so the
+ *         total time is about one measurement time plus the transfer time.
+ *         The function waits once until the last measurement is expected to
+ *         be finished (see SHT3x_WaitMeasurement()).
+ *
+ * @param  Group: Pointer to group
+ * @param  Samples: Pointer to array of samples (Count items)
+ * @param  Results: Pointer to array of results (Count items)
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: All samples are read successfully.
+ *         - SHT3x_FAIL: Reading of at least one sensor failed (see Results).
+ */
+SHT3x_Result_t
+SHT3x_GroupRead(SHT3x_Group_t *Group,
+                SHT3x_Sample_t *Samples, SHT3x_Result_t *Results);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _SHT3X_GROUP_H_
@@ -0,0 +1,185 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_heater.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Heater controller for condensation recovery of SHT3x sensor
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef	_SHT3X_HEATER_H_
+#define _SHT3X_HEATER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "SHT3x.h"
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Heater controller configuration data type
+ * @note   Times are in ms and must be less than 2147483ms (about 35 minutes).
+ *         OnTime, OffTime, Interval and RecoveryInterval must not be 0 and
+ *         OffTime must be longer than SettleTime.
+ */
+typedef struct SHT3x_HeaterConfig_s
+{
+  uint16_t HumidityOn;        // Start recovery at or above this RH (0.01 %)
+  uint16_t HumidityOff;       // End recovery when an unbiased sample is below
+                              // this RH (0.01 %)
+  uint32_t OnTime;            // Heater on time of each duty cycle
+  uint32_t OffTime;           // Heater off time of each duty cycle
+  uint32_t SettleTime;        // Samples are biased until this time passes
+                              // after the heater is turned off
+  uint32_t MaxRecoveryTime;   // Give up the recovery after this time (0: never)
+  uint32_t Interval;          // Sample interval while not recovering
+  uint32_t RecoveryInterval;  // Sample interval while recovering
+} SHT3x_HeaterConfig_t;
+
+/**
+ * @brief  Heater controller state
+ */
+typedef enum SHT3x_HeaterState_e
+{
+  SHT3x_HEATER_IDLE = 0,  // Not recovering, heater is off
+  SHT3x_HEATER_ON,        // Recovering, heater is on
+  SHT3x_HEATER_OFF,       // Recovering, heater is off (duty cycle off time)
+} SHT3x_HeaterState_t;
+
+/**
+ * @brief  Sample of heater controller data type
+ */
+typedef struct SHT3x_HeaterSample_s
+{
+  uint32_t Timestamp;     // Time of sample in us (from PlatformGetTime)
+  SHT3x_Sample_t Sample;
+  uint8_t Biased;         // 1 if the heater was on or the sensor was still
+                          // settling (temperature reads high, RH reads low)
+  uint8_t Recovering;     // 1 if a recovery is in progress
+} SHT3x_HeaterSample_t;
+
+/**
+ * @brief  Heater controller data type
+ */
+typedef struct SHT3x_Heater_s
+{
+  SHT3x_Handler_t *Handler;
+  SHT3x_HeaterConfig_t Config;
+
+  // Number of recoveries stopped by MaxRecoveryTime
+  uint32_t Timeouts;
+
+  // Private data. Do not change them.
+  SHT3x_HeaterState_t State;
+  uint8_t Settling;
+  uint32_t PhaseEnd;
+  uint32_t RecoveryStart;
+  uint32_t HeaterOffTime;
+  uint32_t NextSample;
+} SHT3x_Heater_t;
+
+
+
+/**
+ ==================================================================================
+                          ##### Heater Functions #####                             
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the heater controller and turn the heater off
+ * @note   Handler must be initialized and PlatformGetTime must be set. The
+ *         measurement mode of the handler is not changed.
+ * @note   OffTime must be longer than SettleTime and all times must be less
+ *         than 2147483ms.
+ *
+ * @param  Heater: Pointer to heater controller
+ * @param  Handler: Pointer to handler
+ * @param  Config: Pointer to configuration (copied)
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to turn the heater off.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_HeaterInit(SHT3x_Heater_t *Heater, SHT3x_Handler_t *Handler,
+                 const SHT3x_HeaterConfig_t *Config);
+
+
+/**
+ * @brief  Run the heater controller
+ * @note   Call this function frequently (e.g. in main loop). It switches the
+ *         heater on its duty cycle and reads a sample when the current
+ *         interval is elapsed. It never waits except for reading a sample.
+ * @note   Each change of the heater is verified by the heater bit of the
+ *         status register.
+ *
+ * @param  Heater: Pointer to heater controller
+ * @param  Sample: Pointer to sample
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: A new sample is stored in Sample.
+ *         - SHT3x_NO_DATA: No sample is due.
+ *         - SHT3x_FAIL: Failed to read the sample or to switch the heater.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ */
+SHT3x_Result_t
+SHT3x_HeaterProcess(SHT3x_Heater_t *Heater, SHT3x_HeaterSample_t *Sample);
+
+
+/**
+ * @brief  Stop the recovery in progress and turn the heater off
+ * @param  Heater: Pointer to heater controller
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to turn the heater off.
+ */
+SHT3x_Result_t
+SHT3x_HeaterStop(SHT3x_Heater_t *Heater);
+
+
+/**
+ * @brief  Get the state of the heater controller
+ * @param  Heater: Pointer to heater controller
+ * @retval SHT3x_HeaterState_t
+ */
+SHT3x_HeaterState_t
+SHT3x_HeaterGetState(SHT3x_Heater_t *Heater);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _SHT3X_HEATER_H_
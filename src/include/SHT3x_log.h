@@ -0,0 +1,268 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_log.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Packed sample records and binary log format of SHT3x
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef	_SHT3X_LOG_H_
+#define _SHT3X_LOG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "SHT3x.h"
+
+
+/* Exported Constants -----------------------------------------------------------*/
+/**
+ * @brief  Binary log format
+ * @note   A log is a header followed by fixed size records, so record N is at
+ *         offset SHT3X_LOG_HEADER_SIZE + N * RecordSize. All multi-byte fields
+ *         are little-endian.
+ *
+ *         Header (SHT3X_LOG_HEADER_SIZE bytes):
+ *         | Offset | Size | Field                                          |
+ *         |--------|------|------------------------------------------------|
+ *         | 0      | 4    | Magic "SHT3"                                   |
+ *         | 4      | 1    | Version (SHT3X_LOG_VERSION)                    |
+ *         | 5      | 1    | RecordSize (SHT3X_RECORD_SIZE or               |
+ *         |        |      | SHT3X_TIMED_RECORD_SIZE)                       |
+ *         | 6      | 1    | AddressI2C                                     |
+ *         | 7      | 1    | Mode (SHT3x_Mode_t)                            |
+ *         | 8      | 1    | Repeatability (SHT3x_Repeatability_t)          |
+ *         | 9      | 1    | Speed (SHT3x_Speed_t)                          |
+ *         | 10     | 2    | TimeUnit (ms per TimeDelta unit)               |
+ *         | 12     | 4    | StartTime (user defined, e.g. Unix time)       |
+ *
+ *         Record:
+ *         | Offset | Size | Field                                          |
+ *         |--------|------|------------------------------------------------|
+ *         | 0      | 2    | TimeDelta from the previous record (6 bytes    |
+ *         |        |      | records only, 0 for the first record)          |
+ *         | 0 or 2 | 2    | TempRaw                                        |
+ *         | 2 or 4 | 2    | HumRaw                                         |
+ */
+#define SHT3X_LOG_HEADER_SIZE     16
+#define SHT3X_LOG_VERSION         1
+#define SHT3X_RECORD_SIZE         4
+#define SHT3X_TIMED_RECORD_SIZE   6
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Packed sample record (raw values only)
+ */
+typedef struct SHT3x_Record_s
+{
+  uint16_t  TempRaw;
+  uint16_t  HumRaw;
+} SHT3x_Record_t;
+
+/**
+ * @brief  Packed sample record with time delta
+ */
+typedef struct SHT3x_TimedRecord_s
+{
+  uint16_t  TimeDelta;  // Time from the previous record in TimeUnit of log
+  uint16_t  TempRaw;
+  uint16_t  HumRaw;
+} SHT3x_TimedRecord_t;
+
+/**
+ * @brief  Log header data type
+ */
+typedef struct SHT3x_LogHeader_s
+{
+  uint8_t   RecordSize;
+  uint8_t   AddressI2C;
+  uint8_t   Mode;
+  uint8_t   Repeatability;
+  uint8_t   Speed;
+  uint16_t  TimeUnit;
+  uint32_t  StartTime;
+} SHT3x_LogHeader_t;
+
+/**
+ * @brief  Log writer/reader data type
+ */
+typedef struct SHT3x_Log_s
+{
+  SHT3x_LogHeader_t Header;
+
+  // Private data. Do not change them.
+  uint8_t   Started;
+  uint32_t  LastTime;
+} SHT3x_Log_t;
+
+
+
+/**
+ ==================================================================================
+                           ##### Record Functions #####                            
+ ==================================================================================
+ */
+
+/**
+ * @brief  Pack raw values of a sample to a record
+ * @param  Record: Pointer to record
+ * @param  Sample: Pointer to sample
+ * @retval None
+ */
+void
+SHT3x_RecordPack(SHT3x_Record_t *Record, const SHT3x_Sample_t *Sample);
+
+
+/**
+ * @brief  Unpack a record to a sample
+ * @param  Record: Pointer to record
+ * @param  Sample: Pointer to sample
+ * @param  Conversion: Combination of SHT3x_Conversion_t flags
+ * @retval None
+ */
+void
+SHT3x_RecordUnpack(const SHT3x_Record_t *Record, SHT3x_Sample_t *Sample,
+                   uint8_t Conversion);
+
+
+/**
+ * @brief  Pack raw values of a sample to a record with time delta
+ * @param  Record: Pointer to record
+ * @param  Sample: Pointer to sample
+ * @param  TimeDelta: Time from the previous record (in any unit)
+ * @retval None
+ */
+void
+SHT3x_TimedRecordPack(SHT3x_TimedRecord_t *Record, const SHT3x_Sample_t *Sample,
+                      uint16_t TimeDelta);
+
+
+/**
+ * @brief  Unpack a record with time delta to a sample
+ * @param  Record: Pointer to record
+ * @param  Sample: Pointer to sample
+ * @param  Conversion: Combination of SHT3x_Conversion_t flags
+ * @retval Time delta of the record
+ */
+uint16_t
+SHT3x_TimedRecordUnpack(const SHT3x_TimedRecord_t *Record, SHT3x_Sample_t *Sample,
+                        uint8_t Conversion);
+
+
+
+/**
+ ==================================================================================
+                             ##### Log Functions #####                             
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize a log writer from the current settings of a handler
+ * @param  Log: Pointer to log
+ * @param  Handler: Pointer to handler
+ * @param  RecordSize: SHT3X_RECORD_SIZE or SHT3X_TIMED_RECORD_SIZE
+ * @param  TimeUnit: Time delta unit in ms (1 to 65535, timed records only).
+ *                   The longest time delta is 65535 units.
+ * @param  StartTime: User defined start time stored in header
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_LogInit(SHT3x_Log_t *Log, const SHT3x_Handler_t *Handler,
+              uint8_t RecordSize, uint16_t TimeUnit, uint32_t StartTime);
+
+
+/**
+ * @brief  Write the header of log
+ * @param  Log: Pointer to log
+ * @param  Buffer: Pointer to buffer of SHT3X_LOG_HEADER_SIZE bytes
+ * @retval Number of bytes written (SHT3X_LOG_HEADER_SIZE)
+ */
+uint8_t
+SHT3x_LogPutHeader(const SHT3x_Log_t *Log, uint8_t *Buffer);
+
+
+/**
+ * @brief  Write a record of log
+ * @note   Time delta is rounded down to whole TimeUnit and the remainder is
+ *         carried to the next record, so time does not drift. It is saturated
+ *         at 65535 units.
+ *
+ * @param  Log: Pointer to log
+ * @param  Sample: Pointer to sample
+ * @param  Time: Time of sample in ms (timed records only)
+ * @param  Buffer: Pointer to buffer of Header.RecordSize bytes
+ * 
+ * @retval Number of bytes written (Header.RecordSize)
+ */
+uint8_t
+SHT3x_LogPutRecord(SHT3x_Log_t *Log, const SHT3x_Sample_t *Sample,
+                   uint32_t Time, uint8_t *Buffer);
+
+
+/**
+ * @brief  Read the header of log to initialize a log reader
+ * @param  Log: Pointer to log
+ * @param  Buffer: Pointer to log data
+ * @param  Size: Number of bytes available in Buffer
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_NO_DATA: Buffer is shorter than SHT3X_LOG_HEADER_SIZE.
+ *         - SHT3x_INVALID_PARAM: Magic, version or record size is invalid.
+ */
+SHT3x_Result_t
+SHT3x_LogGetHeader(SHT3x_Log_t *Log, const uint8_t *Buffer, uint32_t Size);
+
+
+/**
+ * @brief  Read a record of log
+ * @param  Log: Pointer to log
+ * @param  Buffer: Pointer to record (Header.RecordSize bytes)
+ * @param  Sample: Pointer to sample
+ * @param  Conversion: Combination of SHT3x_Conversion_t flags
+ * 
+ * @retval Time of record in ms from the first record (0 for untimed records)
+ */
+uint32_t
+SHT3x_LogGetRecord(SHT3x_Log_t *Log, const uint8_t *Buffer, SHT3x_Sample_t *Sample,
+                   uint8_t Conversion);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _SHT3X_LOG_H_
@@ -0,0 +1,183 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_lowpower.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Low-power Single Shot acquisition of SHT3x sensor
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef	_SHT3X_LOWPOWER_H_
+#define _SHT3X_LOWPOWER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "SHT3x.h"
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Sleep function type
+ * @note   The function must put the MCU to a low-power mode for at least Time
+ *         and return after that (e.g. RTC/LPTIM wake-up on STM32 or watchdog
+ *         wake-up on AVR). Waking up later is allowed.
+ *
+ * @param  Context: User context from SHT3x_LowPower_t
+ * @param  Time: Sleep time in us
+ */
+typedef void (*SHT3x_LowPowerSleep_t)(void *Context, uint32_t Time);
+
+/**
+ * @brief  Low-power acquisition data type
+ */
+typedef struct SHT3x_LowPower_s
+{
+  SHT3x_Handler_t *Handler;
+  SHT3x_LowPowerSleep_t Sleep;
+  void *Context;              // Passed to Sleep
+
+  uint32_t Interval;          // Sample interval of SHT3x_LowPowerCycle() in ms
+                              // (less than 2147483 ms)
+
+  // Number of extra sleeps because the sample was not ready in time
+  uint32_t Retries;
+
+  // Private data. Do not change them.
+  uint32_t CycleStart;
+} SHT3x_LowPower_t;
+
+/**
+ * @brief  Energy and time estimate data type
+ * @note   Values are based on typical figures of the datasheet: 600 uA while
+ *         measuring, 0.2 uA idle and 2.5/4.5/12.5 ms measurement duration.
+ *         Bus transfers and the MCU itself are not included.
+ */
+typedef struct SHT3x_LowPowerEstimate_s
+{
+  uint32_t MeasurementTime;     // Typical measurement duration in us
+  uint32_t MeasurementTimeMax;  // Maximum measurement duration in us
+  uint32_t Charge;              // Charge per sample interval in nC
+  uint32_t Energy;              // Energy per sample interval in nJ
+  uint32_t AverageCurrent;      // Average current in nA
+} SHT3x_LowPowerEstimate_t;
+
+
+
+/**
+ ==================================================================================
+                          ##### Low-power Functions #####                          
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the low-power acquisition
+ * @note   Handler must be initialized and in Single Shot mode. Clock
+ *         stretching is disabled, so the bus is free during the measurement.
+ * @note   If PlatformGetTime is set, the time spent on the bus is subtracted
+ *         from sleep times. It must keep counting while the MCU sleeps (e.g.
+ *         RTC or LPTIM instead of SysTick), otherwise leave it NULL.
+ *
+ * @param  LowPower: Pointer to low-power acquisition
+ * @param  Handler: Pointer to handler
+ * @param  Sleep: Sleep function
+ * @param  Context: User context passed to Sleep
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_LowPowerInit(SHT3x_LowPower_t *LowPower, SHT3x_Handler_t *Handler,
+                   SHT3x_LowPowerSleep_t Sleep, void *Context);
+
+
+/**
+ * @brief  Read a sample and sleep during the measurement
+ * @note   The measurement is started, the MCU sleeps for the remaining
+ *         measurement time and the sample is fetched. If the sample is not
+ *         ready, the MCU sleeps 1 ms more (up to 5 times). The sensor goes to
+ *         idle state automatically after the measurement.
+ *
+ * @param  LowPower: Pointer to low-power acquisition
+ * @param  Sample: Pointer to sample buffer
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data or sample was not
+ *                       ready after retries.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ */
+SHT3x_Result_t
+SHT3x_LowPowerRead(SHT3x_LowPower_t *LowPower, SHT3x_Sample_t *Sample);
+
+
+/**
+ * @brief  Read a sample and sleep until the next sample interval
+ * @note   If PlatformGetTime is set, cycles are kept on a grid of Interval
+ *         from SHT3x_LowPowerInit(). Otherwise the maximum measurement time
+ *         is subtracted from Interval. The function sleeps even if reading
+ *         the sample fails.
+ *
+ * @param  LowPower: Pointer to low-power acquisition
+ * @param  Sample: Pointer to sample buffer
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ *         - SHT3x_INVALID_PARAM: Interval is 0.
+ */
+SHT3x_Result_t
+SHT3x_LowPowerCycle(SHT3x_LowPower_t *LowPower, SHT3x_Sample_t *Sample);
+
+
+/**
+ * @brief  Estimate the time and energy consumption of the sensor
+ * @param  Repeatability: Specify repeatability level
+ * @param  Interval: Sample interval in ms (up to 4000000 ms)
+ * @param  Voltage: Supply voltage in mV
+ * @param  Estimate: Pointer to estimate
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_LowPowerEstimate(SHT3x_Repeatability_t Repeatability, uint32_t Interval,
+                       uint16_t Voltage, SHT3x_LowPowerEstimate_t *Estimate);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _SHT3X_LOWPOWER_H_
@@ -0,0 +1,201 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_periodic.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  SHT3x periodic acquisition engine
+ *         Functionalities of the this file:
+ *          + Fetch samples of Periodic and ART modes at the acquisition rate
+ *          + Lock-free single producer single consumer ring buffer of samples
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef	_SHT3X_PERIODIC_H_
+#define _SHT3X_PERIODIC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "SHT3x.h"
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Sample with timestamp data type
+ */
+typedef struct SHT3x_TimedSample_s
+{
+  uint32_t Timestamp; // Time of fetch in us (from PlatformGetTime)
+  SHT3x_Sample_t Sample;
+} SHT3x_TimedSample_t;
+
+/**
+ * @brief  Ring buffer data type
+ * @note   The ring buffer is lock-free for one producer and one consumer.
+ *         Only the producer changes Head and only the consumer changes Tail.
+ * @note   On 8-bit MCUs, 16-bit index access is not atomic. If producer and
+ *         consumer run in different interrupt contexts, protect the calls.
+ */
+typedef struct SHT3x_Ring_s
+{
+  SHT3x_TimedSample_t *Buffer;
+  uint16_t Size;
+
+  // Private data. Do not change them.
+  volatile uint16_t Head;
+  volatile uint16_t Tail;
+} SHT3x_Ring_t;
+
+/**
+ * @brief  Periodic acquisition engine data type
+ */
+typedef struct SHT3x_Periodic_s
+{
+  SHT3x_Handler_t *Handler;
+  SHT3x_Ring_t *Ring;
+
+  // Number of samples dropped because the ring buffer was full
+  uint32_t Dropped;
+} SHT3x_Periodic_t;
+
+
+
+/**
+ ==================================================================================
+                         ##### Ring Buffer Functions #####                         
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize ring buffer
+ * @param  Ring: Pointer to ring buffer
+ * @param  Buffer: Pointer to array of samples supplied by caller
+ * @param  Size: Number of items of Buffer. It must be a power of 2
+ *               (up to 32768).
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_RingInit(SHT3x_Ring_t *Ring, SHT3x_TimedSample_t *Buffer, uint16_t Size);
+
+
+/**
+ * @brief  Push a sample to ring buffer (producer side)
+ * @param  Ring: Pointer to ring buffer
+ * @param  Sample: Pointer to sample
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_FAIL: Ring buffer is full.
+ */
+SHT3x_Result_t
+SHT3x_RingPush(SHT3x_Ring_t *Ring, const SHT3x_TimedSample_t *Sample);
+
+
+/**
+ * @brief  Pop samples from ring buffer (consumer side)
+ * @param  Ring: Pointer to ring buffer
+ * @param  Samples: Pointer to output array
+ * @param  Count: Maximum number of samples to pop
+ * @retval Number of samples popped
+ */
+uint16_t
+SHT3x_RingPop(SHT3x_Ring_t *Ring, SHT3x_TimedSample_t *Samples, uint16_t Count);
+
+
+/**
+ * @brief  Get number of samples in ring buffer
+ * @param  Ring: Pointer to ring buffer
+ * @retval Number of samples
+ */
+uint16_t
+SHT3x_RingCount(SHT3x_Ring_t *Ring);
+
+
+
+/**
+ ==================================================================================
+                     ##### Periodic Acquisition Functions #####                    
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize periodic acquisition engine
+ * @note   The sensor must be set to Periodic or ART mode before and
+ *         PlatformGetTime of the handler must be set.
+ *
+ * @param  Periodic: Pointer to engine
+ * @param  Handler: Pointer to handler
+ * @param  Ring: Pointer to initialized ring buffer
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_PeriodicInit(SHT3x_Periodic_t *Periodic,
+                   SHT3x_Handler_t *Handler, SHT3x_Ring_t *Ring);
+
+
+/**
+ * @brief  Run periodic acquisition engine (producer side)
+ * @note   Call this function frequently (e.g. in main loop or a task). The
+ *         sensor is accessed only when a new sample is due on the sample grid
+ *         of the handler (see SHT3x_NextSampleDueIn()).
+ *
+ * @param  Periodic: Pointer to engine
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: A sample is pushed to ring buffer.
+ *         - SHT3x_NO_DATA: No sample is due yet or the due sample is late
+ *           (it is fetched again on the next call).
+ *         - SHT3x_FAIL: Failed to send or receive data or ring buffer is full.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ */
+SHT3x_Result_t
+SHT3x_PeriodicProcess(SHT3x_Periodic_t *Periodic);
+
+
+/**
+ * @brief  Get the time until the next fetch
+ * @note   It can be used to sleep between calls of SHT3x_PeriodicProcess().
+ * @param  Periodic: Pointer to engine
+ * @retval Time in us (0 if a fetch is due)
+ */
+uint32_t
+SHT3x_PeriodicTimeToNext(SHT3x_Periodic_t *Periodic);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _SHT3X_PERIODIC_H_
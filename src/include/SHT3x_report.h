@@ -0,0 +1,220 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_report.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Report-on-change filter and delta encoding of SHT3x samples
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef	_SHT3X_REPORT_H_
+#define _SHT3X_REPORT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "SHT3x.h"
+
+
+/* Exported Constants -----------------------------------------------------------*/
+/**
+ * @brief  Maximum size of a delta encoded record in bytes
+ */
+#define SHT3X_DELTA_MAX_SIZE  6
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Report-on-change filter data type
+ * @note   Heartbeat is in ms. Any value is allowed, but the filter must be
+ *         called at least once in 4294s (about 71 minutes, the wrap time of
+ *         PlatformGetTime), so the elapsed time can be tracked.
+ */
+typedef struct SHT3x_Report_s
+{
+  SHT3x_Handler_t *Handler;
+  uint16_t TempDeadband;  // Deliver if TempRaw changes more than this
+  uint16_t HumDeadband;   // Deliver if HumRaw changes more than this
+  uint32_t Heartbeat;     // Deliver at least once in this time (0: never)
+
+  uint32_t Delivered;     // Number of delivered samples
+  uint32_t Suppressed;    // Number of suppressed samples
+
+  // Private data. Do not change them.
+  uint8_t Valid;
+  uint16_t LastTempRaw;
+  uint16_t LastHumRaw;
+  uint32_t LastTime;      // Time of the last call in us
+  uint32_t Elapsed;       // Time since the last delivered sample in ms
+  uint16_t ElapsedUs;     // Remainder of Elapsed in us
+} SHT3x_Report_t;
+
+/**
+ * @brief  Delta encoder/decoder data type
+ * @note   Each record is the difference of TempRaw and HumRaw from the previous
+ *         record (modulo 65536), zigzag mapped and written as two varints of
+ *         7 bits per byte (LSB first, MSB set if more bytes follow). Small
+ *         changes take 2 bytes and the first record of a stream (difference
+ *         from 0) takes at most SHT3X_DELTA_MAX_SIZE bytes.
+ */
+typedef struct SHT3x_Delta_s
+{
+  // Private data. Do not change them.
+  uint16_t TempRaw;
+  uint16_t HumRaw;
+} SHT3x_Delta_t;
+
+
+
+/**
+ ==================================================================================
+                           ##### Report Functions #####                            
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the report-on-change filter
+ * @note   Handler must be initialized. PlatformGetTime must be set if Heartbeat
+ *         is not 0.
+ *
+ * @param  Report: Pointer to filter
+ * @param  Handler: Pointer to handler
+ * @param  TempDeadband: Temperature deadband in raw units
+ * @param  HumDeadband: Humidity deadband in raw units
+ * @param  Heartbeat: Heartbeat interval in ms (0: no heartbeat)
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_ReportInit(SHT3x_Report_t *Report, SHT3x_Handler_t *Handler,
+                 uint16_t TempDeadband, uint16_t HumDeadband, uint32_t Heartbeat);
+
+
+/**
+ * @brief  Check if a sample passes the filter
+ * @note   A sample passes if it is the first one, if TempRaw or HumRaw differs
+ *         from the last delivered sample more than its deadband or if the
+ *         heartbeat interval is elapsed since the last delivered sample.
+ *
+ * @param  Report: Pointer to filter
+ * @param  Sample: Pointer to sample (only TempRaw and HumRaw are used)
+ * 
+ * @retval 1: Sample must be delivered, 0: Sample is suppressed
+ */
+uint8_t
+SHT3x_ReportFilter(SHT3x_Report_t *Report, const SHT3x_Sample_t *Sample);
+
+
+/**
+ * @brief  Read a sample and deliver it only if it passes the filter
+ * @note   The sample is converted (see SHT3x_SetConversion()) only if it is
+ *         delivered.
+ *
+ * @param  Report: Pointer to filter
+ * @param  Sample: Pointer to sample
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: A new sample is delivered.
+ *         - SHT3x_NO_DATA: The sample is suppressed (only raw values are valid)
+ *           or no measurement data is present.
+ *         - SHT3x_FAIL: Failed to send or receive data.
+ *         - SHT3x_CRC_ERROR: CRC check error.
+ */
+SHT3x_Result_t
+SHT3x_ReportReadSample(SHT3x_Report_t *Report, SHT3x_Sample_t *Sample);
+
+
+/**
+ * @brief  Deliver the next sample whatever its value is
+ * @param  Report: Pointer to filter
+ * @retval None
+ */
+void
+SHT3x_ReportForce(SHT3x_Report_t *Report);
+
+
+
+/**
+ ==================================================================================
+                       ##### Delta Encoding Functions #####                        
+ ==================================================================================
+ */
+
+/**
+ * @brief  Start a new delta encoded stream
+ * @note   Encoder and decoder must be started together (e.g. at the start of
+ *         each packet, so packets can be decoded one by one).
+ *
+ * @param  Delta: Pointer to encoder/decoder
+ * 
+ * @retval None
+ */
+void
+SHT3x_DeltaInit(SHT3x_Delta_t *Delta);
+
+
+/**
+ * @brief  Encode raw values of a sample
+ * @param  Delta: Pointer to encoder
+ * @param  Sample: Pointer to sample (only TempRaw and HumRaw are used)
+ * @param  Buffer: Pointer to buffer of at least SHT3X_DELTA_MAX_SIZE bytes
+ * 
+ * @retval Number of bytes written to Buffer (2 to SHT3X_DELTA_MAX_SIZE)
+ */
+uint8_t
+SHT3x_DeltaEncode(SHT3x_Delta_t *Delta, const SHT3x_Sample_t *Sample,
+                  uint8_t *Buffer);
+
+
+/**
+ * @brief  Decode raw values of a sample
+ * @note   Only TempRaw and HumRaw of the sample are set. Use
+ *         SHT3x_ConvertSample() to convert them.
+ *
+ * @param  Delta: Pointer to decoder
+ * @param  Buffer: Pointer to encoded data
+ * @param  Size: Number of bytes available in Buffer
+ * @param  Sample: Pointer to sample
+ * 
+ * @retval Number of bytes read from Buffer (0: record is truncated or invalid)
+ */
+uint8_t
+SHT3x_DeltaDecode(SHT3x_Delta_t *Delta, const uint8_t *Buffer, uint16_t Size,
+                  SHT3x_Sample_t *Sample);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _SHT3X_REPORT_H_
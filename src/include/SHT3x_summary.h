@@ -0,0 +1,223 @@
+/**
+ **********************************************************************************
+ * @file   SHT3x_summary.h
+ * @author Hossein.M (https://github.com/Hossein-M98)
+ * @brief  Streaming statistics (mean, min, max, dew point) of SHT3x samples
+ **********************************************************************************
+ *
+ * Copyright (c) 2023 Mahda Embedded System (MIT License)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ **********************************************************************************
+ */
+
+
+/* Define to prevent recursive inclusion ----------------------------------------*/
+#ifndef	_SHT3X_SUMMARY_H_
+#define _SHT3X_SUMMARY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Includes ---------------------------------------------------------------------*/
+#include <stdint.h>
+#include "SHT3x.h"
+
+
+/* Exported Data Types ----------------------------------------------------------*/
+/**
+ * @brief  Averaging mode of summary
+ */
+typedef enum SHT3x_SummaryMode_e
+{
+  SHT3x_SUMMARY_WINDOW = 0, // Mean of the last N samples (sliding window)
+  SHT3x_SUMMARY_EMA,        // Exponential moving average (alpha = 1 / 2^N)
+} SHT3x_SummaryMode_t;
+
+/**
+ * @brief  One slot of the sliding window buffer
+ */
+typedef struct SHT3x_SummaryPoint_s
+{
+  int16_t   Temperature;  // in 0.01 C
+  uint16_t  Humidity;     // in 0.01 %
+} SHT3x_SummaryPoint_t;
+
+/**
+ * @brief  Summary report data type
+ * @note   Temperatures are in 0.01 C, relative humidities in 0.01 % and
+ *         absolute humidity in 0.01 g/m^3.
+ */
+typedef struct SHT3x_SummaryResult_s
+{
+  uint32_t  Count;            // Samples added since the last reset
+  int16_t   TempMean;         // Mean of the window or EMA
+  int16_t   TempMin;          // Minimum since the last reset
+  int16_t   TempMax;          // Maximum since the last reset
+  uint16_t  HumMean;          // Mean of the window or EMA
+  uint16_t  HumMin;           // Minimum since the last reset
+  uint16_t  HumMax;           // Maximum since the last reset
+  int16_t   DewPoint;         // Dew point of the means
+  uint32_t  AbsoluteHumidity; // Absolute humidity of the means
+} SHT3x_SummaryResult_t;
+
+/**
+ * @brief  Summary data type
+ */
+typedef struct SHT3x_Summary_s
+{
+  SHT3x_SummaryMode_t Mode;
+
+  // Private data. Do not change them.
+  SHT3x_SummaryPoint_t *Buffer;
+  uint16_t  Length;
+  uint16_t  Index;
+  uint16_t  Filled;
+  int32_t   TempAcc;  // Window sum or EMA in 1/65536 of 0.01 C
+  int32_t   HumAcc;   // Window sum or EMA in 1/65536 of 0.01 %
+  uint32_t  Count;
+  int16_t   TempMin;
+  int16_t   TempMax;
+  uint16_t  HumMin;
+  uint16_t  HumMax;
+} SHT3x_Summary_t;
+
+
+
+/**
+ ==================================================================================
+                           ##### Summary Functions #####                           
+ ==================================================================================
+ */
+
+/**
+ * @brief  Initialize the summary
+ * @note   All calculations are done in integer math and each sample is added
+ *         in O(1) time in both modes.
+ *
+ * @param  Summary: Pointer to summary
+ * @param  Mode: Averaging mode
+ * @param  Length:
+ *         - SHT3x_SUMMARY_WINDOW: Number of samples of the window (1 to 65535)
+ *         - SHT3x_SUMMARY_EMA: N of alpha = 1 / 2^N (1 to 15)
+ * @param  Buffer: Window buffer of Length slots (SHT3x_SUMMARY_WINDOW only,
+ *                 NULL for SHT3x_SUMMARY_EMA)
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_INVALID_PARAM: One of parameters is invalid.
+ */
+SHT3x_Result_t
+SHT3x_SummaryInit(SHT3x_Summary_t *Summary, SHT3x_SummaryMode_t Mode,
+                  uint16_t Length, SHT3x_SummaryPoint_t *Buffer);
+
+
+/**
+ * @brief  Add a sample to the summary
+ * @note   Only TempRaw and HumRaw of the sample are used, so the conversions
+ *         of the handler can be disabled.
+ *
+ * @param  Summary: Pointer to summary
+ * @param  Sample: Pointer to sample
+ * 
+ * @retval None
+ */
+void
+SHT3x_SummaryAdd(SHT3x_Summary_t *Summary, const SHT3x_Sample_t *Sample);
+
+
+/**
+ * @brief  Read a sample by SHT3x_ReadSample() and add it to the summary
+ * @param  Summary: Pointer to summary
+ * @param  Handler: Pointer to handler
+ * @param  Sample: Pointer to sample (may be NULL)
+ * 
+ * @retval SHT3x_Result_t (same as SHT3x_ReadSample())
+ */
+SHT3x_Result_t
+SHT3x_SummaryReadSample(SHT3x_Summary_t *Summary, SHT3x_Handler_t *Handler,
+                        SHT3x_Sample_t *Sample);
+
+
+/**
+ * @brief  Get the summary report
+ * @note   Dew point and absolute humidity are calculated here from the means,
+ *         not for each sample.
+ *
+ * @param  Summary: Pointer to summary
+ * @param  Result: Pointer to report
+ * 
+ * @retval SHT3x_Result_t
+ *         - SHT3x_OK: Operation was successful.
+ *         - SHT3x_NO_DATA: No sample is added since the last reset.
+ */
+SHT3x_Result_t
+SHT3x_SummaryGet(const SHT3x_Summary_t *Summary, SHT3x_SummaryResult_t *Result);
+
+
+/**
+ * @brief  Start a new report period
+ * @note   Count, minimums and maximums are cleared. The window and the EMA
+ *         are kept, so the means stay continuous over periods.
+ *
+ * @param  Summary: Pointer to summary
+ * 
+ * @retval None
+ */
+void
+SHT3x_SummaryReset(SHT3x_Summary_t *Summary);
+
+
+/**
+ * @brief  Calculate dew point by the Magnus formula (over water)
+ * @note   Integer math only. Error is less than 0.02 C compared to the same
+ *         formula in floating point math.
+ *
+ * @param  Temperature: Temperature in 0.01 C
+ * @param  Humidity: Relative humidity in 0.01 %
+ * 
+ * @retval Dew point in 0.01 C
+ */
+int16_t
+SHT3x_DewPoint(int16_t Temperature, uint16_t Humidity);
+
+
+/**
+ * @brief  Calculate absolute humidity (water vapor density)
+ * @note   Integer math only. Uses the same Magnus formula as SHT3x_DewPoint().
+ *         Error is less than 0.2 % or 0.01 g/m^3.
+ *
+ * @param  Temperature: Temperature in 0.01 C
+ * @param  Humidity: Relative humidity in 0.01 %
+ * 
+ * @retval Absolute humidity in 0.01 g/m^3
+ */
+uint32_t
+SHT3x_AbsoluteHumidity(int16_t Temperature, uint16_t Humidity);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //! _SHT3X_SUMMARY_H_